@@ -3,6 +3,7 @@ import { findChangedProps, isEmpty, isKeyOfRecord, safeParseFloat } from './misc
 import { getAllStyles } from './parsers/cssstyle_parser';
 import { parseCursor, parseTransform, parseTransformPivot, parseTranslate, parseVisibility } from './parsers/common_props_parser';
 import * as puerts from 'puerts';
+import { commitBatch } from './misc/commit_batch';
 export abstract class ElementConverter {
     typeName: string;
     props: any;
@@ -122,20 +123,28 @@ export abstract class ElementConverter {
     private initOrUpdateCommonProperties(widget: UE.Widget, changeProps: any) {
         const styles = getAllStyles(this.typeName, changeProps);
 
+        // plain values go into the commit batch, structs and delegates still need puerts.merge
         const widgetProps = {};
+        let changed = false;
         for (const key in this.translators) {
             const propName = this.PropMaps[key];
             if (isKeyOfRecord(propName, styles) || isKeyOfRecord(propName, changeProps)) {
                 const value = this.translators[key](styles, changeProps);
                 if (value !== null) {
-                    widgetProps[key] = value;
+                    if (!commitBatch.setProperty(widget, key, value)) {
+                        widgetProps[key] = value;
+                    }
+                    changed = true;
                 }
             }
         }
 
         if (!isEmpty(widgetProps)) {
             puerts.merge(widget, widgetProps);
-            UE.UMGManager.SynchronizeWidgetProperties(widget);
+        }
+
+        if (changed) {
+            commitBatch.sync(widget);
         }
     }
 }
@@ -2,6 +2,7 @@ import * as Reconciler from 'react-reconciler';
 import * as puerts from 'puerts';
 import * as UE from 'ue';
 import { createElementConverter, ElementConverter } from './converter';
+import { commitBatch } from './misc/commit_batch';
 
 /**
  * Compares two values for deep equality.
@@ -121,7 +122,8 @@ const hostConfig : Reconciler.HostConfig<string, any, RootContainer, UMGWidget,
     finalizeInitialChildren () { return false; },
     getPublicInstance (instance: UMGWidget) { return instance.native; },
     prepareForCommit(containerInfo: RootContainer): any {},
-    resetAfterCommit (container: RootContainer) {},
+    // apply every mutation recorded during this commit with a single native call
+    resetAfterCommit (container: RootContainer) { commitBatch.flush(); },
     resetTextContent (instance: UMGWidget) { },
     shouldSetTextContent (type, props) {
         const textContainers = new Set([
@@ -177,7 +179,7 @@ const hostConfig : Reconciler.HostConfig<string, any, RootContainer, UMGWidget,
     afterActiveInstanceBlur() {},
     prepareScopeUpdate(scopeInstance: any, instance: any) {},
     getInstanceFromScope(scopeInstance: any) { return null; },
-    detachDeletedInstance(node: any){},
+    detachDeletedInstance(node: UMGWidget){ commitBatch.release(node?.native); },
 
     supportsMutation: true,
     isPrimaryRenderer: true,
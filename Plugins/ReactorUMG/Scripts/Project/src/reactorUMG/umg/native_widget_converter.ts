@@ -1,6 +1,7 @@
 import { UMGConverter } from "./umg_converter";
 import * as UE from 'ue';
 import * as puerts from 'puerts';
+import { commitBatch } from '../misc/commit_batch';
 
 export class NativeWidgetConverter extends UMGConverter {
     private callbackRecords: {[key: string] : () => void};
@@ -85,19 +86,19 @@ export class NativeWidgetConverter extends UMGConverter {
 
         if (propsChanged) {
             puerts.merge(widget, propsChanged);
-            UE.UMGManager.SynchronizeWidgetProperties(widget);
+            commitBatch.sync(widget);
         }
     }
 
     appendChild(parent: UE.Widget, child: UE.Widget, childTypeName: string, childProps: any): void {
         if (parent instanceof UE.PanelWidget) {
-            parent.AddChild(child);
+            commitBatch.appendChild(parent, child);
         }
     }
 
     removeChild(parent: UE.Widget, child: UE.Widget): void {
         if (parent instanceof UE.PanelWidget) {
-            parent.RemoveChild(child);
+            commitBatch.removeChild(parent, child);
         }
     }
 }
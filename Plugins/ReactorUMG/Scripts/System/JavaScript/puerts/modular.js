@@ -677,6 +677,15 @@ var global = global || (function () { return this; }());
 
     registerBuildinModule("puerts", puerts)
 
+    // modules already evaluated in the startup snapshot this env booted from, see FJsEnvSnapshot
+    if (global.__puertsSnapshotModules) {
+        const snapshotModules = global.__puertsSnapshotModules;
+        delete global.__puertsSnapshotModules;
+        for (const name in snapshotModules) {
+            registerBuildinModule(name, snapshotModules[name]);
+        }
+    }
+
     puerts.genRequire = genRequire;
     
     puerts.getESMMain = getESMMain;
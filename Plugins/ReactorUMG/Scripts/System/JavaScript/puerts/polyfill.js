@@ -8,5 +8,5 @@
 var global = global || (function () { return this; }());
 (function (global) {
     "use strict";
-    global.process = { env: { NODE_ENV: 'development' } };
+    global.process = { env: { NODE_ENV: global.puerts.nodeEnv || 'development' } };
 }(global));
\ No newline at end of file
@@ -0,0 +1,130 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "CodeCacheStore.h"
+#include "JSLogger.h"
+#include "Async/Async.h"
+#include "Hash/CityHash.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+
+#if !defined(WITH_QUICKJS)
+namespace PUERTS_NAMESPACE
+{
+namespace
+{
+constexpr uint32 StoredCodeCacheMagic = 0x4A53434Bu;    // 'JSCK'
+
+struct FStoredCodeCacheHeader
+{
+    uint32 Magic;
+    uint32 FlagHash;
+    uint64 SourceHash;
+    uint32 PayloadLength;
+    uint32 Reserved;
+};
+}    // namespace
+
+void FCodeCacheStore::Initialize(const FString& InCacheDir, uint32 InFlagHash)
+{
+    CacheDir = InCacheDir;
+    FlagHash = InFlagHash;
+    if (!CacheDir.IsEmpty() && !IFileManager::Get().MakeDirectory(*CacheDir, true))
+    {
+        UE_LOG(Puerts, Warning, TEXT("can not create code cache directory %s, persistent code cache disabled"), *CacheDir);
+        CacheDir.Empty();
+    }
+}
+
+FString FCodeCacheStore::GetCacheFile(const FString& ModulePath) const
+{
+    const uint64 PathHash = CityHash64(reinterpret_cast<const char*>(*ModulePath), ModulePath.Len() * sizeof(TCHAR));
+    return CacheDir / FString::Printf(TEXT("%016llx.jscache"), PathHash);
+}
+
+bool FCodeCacheStore::Load(const FString& ModulePath, uint64 SourceHash, TArray<uint8>& OutData) const
+{
+    if (!IsEnabled() || !FFileHelper::LoadFileToArray(OutData, *GetCacheFile(ModulePath), FILEREAD_Silent))
+    {
+        return false;
+    }
+
+    FStoredCodeCacheHeader Header;
+    if (OutData.Num() <= static_cast<int32>(sizeof(Header)))
+    {
+        return false;
+    }
+    FMemory::Memcpy(&Header, OutData.GetData(), sizeof(Header));
+
+    if (Header.Magic != StoredCodeCacheMagic || Header.FlagHash != FlagHash || Header.SourceHash != SourceHash ||
+        Header.PayloadLength != static_cast<uint32>(OutData.Num() - sizeof(Header)))
+    {
+        return false;
+    }
+
+    OutData.RemoveAt(0, sizeof(Header), EAllowShrinking::No);
+    return true;
+}
+
+void FCodeCacheStore::Save(const FString& ModulePath, uint64 SourceHash, v8::ScriptCompiler::CachedData* CachedData) const
+{
+    if (!CachedData)
+    {
+        return;
+    }
+
+    TArray<uint8> Bytes;
+    if (IsEnabled() && CachedData->length > 0)
+    {
+        FStoredCodeCacheHeader Header;
+        Header.Magic = StoredCodeCacheMagic;
+        Header.FlagHash = FlagHash;
+        Header.SourceHash = SourceHash;
+        Header.PayloadLength = CachedData->length;
+        Header.Reserved = 0;
+
+        Bytes.Reserve(sizeof(Header) + CachedData->length);
+        Bytes.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+        Bytes.Append(CachedData->data, CachedData->length);
+    }
+#if !WITH_EDITOR
+    delete CachedData;    //编辑器下是v8.dll分配的，ue里的delete被重载了，这delete会有问题
+#endif
+
+    if (Bytes.Num() == 0)
+    {
+        return;
+    }
+
+    // write to a unique temp file first, several envs may compile the same module at the same time
+    const FString CacheFile = GetCacheFile(ModulePath);
+    Async(EAsyncExecution::ThreadPool,
+        [CacheFile, Bytes = MoveTemp(Bytes)]()
+        {
+            const FString TempFile = CacheFile + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+            if (FFileHelper::SaveArrayToFile(Bytes, *TempFile))
+            {
+                IFileManager::Get().Move(*CacheFile, *TempFile, true, true, false, true);
+            }
+        });
+}
+
+uint64 FCodeCacheStore::HashSource(const uint8* Data, int32 Length)
+{
+    return CityHash64(reinterpret_cast<const char*>(Data), Length);
+}
+
+uint64 FCodeCacheStore::HashSource(v8::Isolate* Isolate, v8::Local<v8::String> Source)
+{
+    v8::String::Value Chars(Isolate, Source);
+    return CityHash64(reinterpret_cast<const char*>(*Chars), Chars.length() * sizeof(uint16_t));
+}
+}    // namespace PUERTS_NAMESPACE
+#endif
@@ -0,0 +1,64 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NamespaceDef.h"
+
+PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#pragma warning(push, 0)
+#include "v8.h"
+#pragma warning(pop)
+PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
+
+#if !defined(WITH_QUICKJS)
+namespace PUERTS_NAMESPACE
+{
+/**
+ * Persists the V8 code cache of compiled CommonJS/ES modules so later launches skip parsing and compiling unchanged files.
+ * An entry is found by module path and only handed out if the source hash and V8 flag hash still match,
+ * V8 itself rejects caches of another version/snapshot, in which case the entry is simply rewritten.
+ */
+class FCodeCacheStore
+{
+public:
+    FCodeCacheStore() : FlagHash(0)
+    {
+    }
+
+    void Initialize(const FString& InCacheDir, uint32 InFlagHash);
+
+    bool IsEnabled() const
+    {
+        return !CacheDir.IsEmpty();
+    }
+
+    /**
+     * @param OutData V8 payload, must stay alive until the compile consuming it has finished
+     */
+    bool Load(const FString& ModulePath, uint64 SourceHash, TArray<uint8>& OutData) const;
+
+    /**
+     * Takes ownership of CachedData, the file is written on a worker thread
+     */
+    void Save(const FString& ModulePath, uint64 SourceHash, v8::ScriptCompiler::CachedData* CachedData) const;
+
+    static uint64 HashSource(const uint8* Data, int32 Length);
+
+    static uint64 HashSource(v8::Isolate* Isolate, v8::Local<v8::String> Source);
+
+private:
+    FString GetCacheFile(const FString& ModulePath) const;
+
+    FString CacheDir;
+
+    uint32 FlagHash;
+};
+}    // namespace PUERTS_NAMESPACE
+#endif
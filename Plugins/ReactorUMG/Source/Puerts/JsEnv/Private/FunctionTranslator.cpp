@@ -10,6 +10,7 @@
 #include "V8Utils.h"
 #include "Misc/DefaultValueHelper.h"
 #include <mutex>
+#include <utility>
 
 static TMap<FName, TMap<FName, TMap<FName, FString>>> ParamDefaultMetas;
 
@@ -86,6 +87,66 @@ public:
 static GlobalBufferAutoRelease Dummy;
 #endif
 
+static TSet<const UFunction*>& GetFastCallFunctions()
+{
+    static TSet<const UFunction*> FastCallFunctions;
+    return FastCallFunctions;
+}
+
+#if PUERTS_REFLECTED_FAST_CALL
+// the most parameters a fast call is generated for
+static const int MAX_FAST_CALL_ARGS = 6;
+
+// every argument is taken as a v8::Local<v8::Value> and checked by CallFast, so one entry point per return type and
+// argument count covers every signature
+template <typename Ret, size_t... Indices>
+struct TReflectedFastCall<Ret, std::index_sequence<Indices...>>
+{
+    template <size_t>
+    using FArgument = v8::Local<v8::Value>;
+
+    static Ret Call(v8::Local<v8::Object> Receiver, FArgument<Indices>... Args, v8::FastApiCallbackOptions& Options)
+    {
+        // one more element, an array can not be empty
+        const v8::Local<v8::Value> ArgArray[] = {Args..., v8::Local<v8::Value>()};
+        FFunctionTranslator* Translator = static_cast<FFunctionTranslator*>(v8::External::Cast(&Options.data)->Value());
+        FFunctionTranslator::FFastCallResult Result{};
+        if (!Translator->CallFast(Receiver, ArgArray, sizeof...(Indices), Result))
+        {
+            Options.fallback = true;
+            return Ret();
+        }
+
+        if constexpr (std::is_same<Ret, bool>::value)
+        {
+            return Result.BoolValue;
+        }
+        else if constexpr (std::is_same<Ret, int32_t>::value)
+        {
+            return Result.Int32Value;
+        }
+        else if constexpr (std::is_same<Ret, double>::value)
+        {
+            return Result.Float64Value;
+        }
+    }
+};
+
+template <typename Ret, size_t... ArgCounts>
+static const void* GetFastCallAddress(int ArgCount, std::index_sequence<ArgCounts...>)
+{
+    static const void* const Addresses[] = {
+        reinterpret_cast<const void*>(&TReflectedFastCall<Ret, std::make_index_sequence<ArgCounts>>::Call)...};
+    return Addresses[ArgCount];
+}
+#endif
+
+void FFunctionTranslator::AddFastCallFunction(UFunction* InFunction)
+{
+    check(InFunction);
+    GetFastCallFunctions().Add(InFunction);
+}
+
 FFunctionTranslator::FFunctionTranslator(UFunction* InFunction, bool IsDelegate)
 {
     Init(InFunction, IsDelegate);
@@ -209,10 +270,252 @@ void FFunctionTranslator::Init(UFunction* InFunction, bool IsDelegate)
             }
         }
     }
+
+#if PUERTS_REFLECTED_FAST_CALL
+    InitFastCall(InFunction, IsDelegate);
+#endif
+}
+
+#if PUERTS_REFLECTED_FAST_CALL
+void FFunctionTranslator::InitFastCall(UFunction* InFunction, bool IsDelegate)
+{
+    FastCallEnabled = false;
+    if (IsDelegate || IsInterfaceFunction || Arguments.size() > MAX_FAST_CALL_ARGS || !GetFastCallFunctions().Contains(InFunction) ||
+        !InFunction->HasAnyFunctionFlags(FUNC_Native) || InFunction->HasAnyFunctionFlags(FUNC_Net | FUNC_UbergraphFunction))
+    {
+        return;
+    }
+
+    // the property the value is written with, null if the parameter has no fast path
+    auto GetFastCallProperty = [](PropertyMacro* Property, EFastCallType& OutType) -> PropertyMacro*
+    {
+        if (Property->ArrayDim != 1)
+        {
+            return nullptr;
+        }
+        if (Property->IsA<BoolPropertyMacro>())
+        {
+            OutType = EFastCallType::Bool;
+            return Property;
+        }
+        if (Property->IsA<ObjectPropertyMacro>())
+        {
+            OutType = EFastCallType::Object;
+            return Property;
+        }
+        if (EnumPropertyMacro* EnumProperty = CastFieldMacro<EnumPropertyMacro>(Property))
+        {
+            Property = EnumProperty->GetUnderlyingProperty();
+        }
+        NumericPropertyMacro* NumericProperty = CastFieldMacro<NumericPropertyMacro>(Property);
+        if (NumericProperty && NumericProperty->IsFloatingPoint())
+        {
+            OutType = EFastCallType::Float64;
+            return Property;
+        }
+        // uint32 and 64 bit integers do not fit in an int32
+        if (NumericProperty && NumericProperty->IsInteger() &&
+            (Property->GetSize() < 4 || Property->IsA<IntPropertyMacro>()))
+        {
+            OutType = EFastCallType::Int32;
+            return Property;
+        }
+        return nullptr;
+    };
+
+    std::vector<FFastCallParam> Params;
+    for (const std::unique_ptr<FPropertyTranslator>& Argument : Arguments)
+    {
+        PropertyMacro* Property = Argument->Property;
+        FFastCallParam Param;
+        Param.Property = Property->HasAnyPropertyFlags(CPF_OutParm | CPF_ReferenceParm)
+                             ? nullptr
+                             : GetFastCallProperty(Property, Param.Type);
+        if (!Param.Property)
+        {
+            return;
+        }
+        Param.Offset = Property->GetOffset_ForUFunction();
+        Params.push_back(Param);
+    }
+
+    EFastCallType ReturnType = EFastCallType::None;
+    PropertyMacro* ReturnProperty = nullptr;
+    if (Return)
+    {
+        // returning an object would allocate its wrapper
+        ReturnProperty = GetFastCallProperty(Return->Property, ReturnType);
+        if (!ReturnProperty || ReturnType == EFastCallType::Object)
+        {
+            return;
+        }
+    }
+
+    const v8::CTypeInfo::Type ReturnCType = ReturnType == EFastCallType::Bool    ? v8::CTypeInfo::Type::kBool
+                                            : ReturnType == EFastCallType::Int32 ? v8::CTypeInfo::Type::kInt32
+                                            : ReturnType == EFastCallType::Float64 ? v8::CTypeInfo::Type::kFloat64
+                                                                                   : v8::CTypeInfo::Type::kVoid;
+    if (FastCallInfo)
+    {
+        // reinitialized with another signature, the function templates still use the first one
+        if (FastCallInfo->ArgumentCount() != Params.size() + 1 || FastCallInfo->ReturnInfo().GetType() != ReturnCType)
+        {
+            return;
+        }
+    }
+    else
+    {
+        // the receiver, the arguments and the options
+        FastCallArgInfos.reserve(Params.size() + 2);
+        for (size_t i = 0; i < Params.size() + 1; ++i)
+        {
+            FastCallArgInfos.emplace_back(v8::CTypeInfo::Type::kV8Value);
+        }
+        FastCallArgInfos.emplace_back(v8::CTypeInfo::kCallbackOptionsType);
+        FastCallInfo = std::make_unique<v8::CFunctionInfo>(
+            v8::CTypeInfo(ReturnCType), static_cast<unsigned int>(FastCallArgInfos.size()), FastCallArgInfos.data());
+
+        const int ArgCount = static_cast<int>(Params.size());
+        const auto ArgCounts = std::make_index_sequence<MAX_FAST_CALL_ARGS + 1>();
+        const void* Address = ReturnType == EFastCallType::Bool    ? GetFastCallAddress<bool>(ArgCount, ArgCounts)
+                              : ReturnType == EFastCallType::Int32 ? GetFastCallAddress<int32_t>(ArgCount, ArgCounts)
+                              : ReturnType == EFastCallType::Float64 ? GetFastCallAddress<double>(ArgCount, ArgCounts)
+                                                                     : GetFastCallAddress<void>(ArgCount, ArgCounts);
+        FastCallFunction = v8::CFunction(Address, FastCallInfo.get());
+    }
+
+    FastCallParams = std::move(Params);
+    FastCallReturn.Property = ReturnProperty;
+    FastCallReturn.Offset = Return ? Return->Property->GetOffset_ForUFunction() : 0;
+    FastCallReturn.Type = ReturnType;
+    FastCallEnabled = true;
+}
+
+bool FFunctionTranslator::CallFast(
+    v8::Local<v8::Object> Receiver, const v8::Local<v8::Value>* Args, int ArgCount, FFastCallResult& Result)
+{
+    if (!FastCallEnabled || ArgCount != static_cast<int>(FastCallParams.size()))
+    {
+        return false;
+    }
+
+    // the slow callback binds the static object, reinitializes a reloaded function and throws
+    UFunction* CallFunction = Function.Get();
+    UObject* CallObject = IsStatic ? BindObject.Get() : FV8Utils::GetUObject(Receiver);
+    if (!CallFunction || !CallObject || FV8Utils::IsReleasedPtr(CallObject))
+    {
+        return false;
+    }
+
+#if defined(USE_GLOBAL_PARAMS_BUFFER)
+    uint8* Params = static_cast<uint8*>(Buffer);
+#else
+    uint8* Params = ParamsBufferSize > 0 ? static_cast<uint8*>(FMemory_Alloca(ParamsBufferSize)) : nullptr;
+#endif
+
+    // nothing may have been called before a value falls back
+    for (int i = 0; i < ArgCount; ++i)
+    {
+        const FFastCallParam& Param = FastCallParams[i];
+        const v8::Local<v8::Value>& Value = Args[i];
+        void* ValuePtr = Params + Param.Offset;
+        switch (Param.Type)
+        {
+            case EFastCallType::Bool:
+                if (!Value->IsBoolean())
+                {
+                    return false;
+                }
+                static_cast<BoolPropertyMacro*>(Param.Property)->SetPropertyValue(ValuePtr, Value.As<v8::Boolean>()->Value());
+                break;
+            case EFastCallType::Int32:
+                if (!Value->IsInt32())
+                {
+                    return false;
+                }
+                static_cast<NumericPropertyMacro*>(Param.Property)
+                    ->SetIntPropertyValue(ValuePtr, static_cast<int64>(Value.As<v8::Int32>()->Value()));
+                break;
+            case EFastCallType::Float64:
+                if (!Value->IsNumber())
+                {
+                    return false;
+                }
+                static_cast<NumericPropertyMacro*>(Param.Property)
+                    ->SetFloatingPointPropertyValue(ValuePtr, Value.As<v8::Number>()->Value());
+                break;
+            case EFastCallType::Object:
+            {
+                UObject* Object = nullptr;
+                if (Value->IsObject())
+                {
+                    Object = FV8Utils::GetUObject(Value.As<v8::Object>());
+                    if (FV8Utils::IsReleasedPtr(Object))
+                    {
+                        return false;
+                    }
+                }
+                // an undefined argument takes its default value, which only the slow path copies
+                else if (Value->IsUndefined() ? ArgumentDefaultValues != nullptr : !Value->IsNull())
+                {
+                    return false;
+                }
+                static_cast<ObjectPropertyBaseMacro*>(Param.Property)->SetObjectPropertyValue(ValuePtr, Object);
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+
+    if (FastCallReturn.Property)
+    {
+        FastCallReturn.Property->InitializeValue(Params + FastCallReturn.Offset);
+    }
+
+    FFrame NewStack(CallObject, CallFunction, Params, nullptr,
+#if ENGINE_MINOR_VERSION >= 25 || ENGINE_MAJOR_VERSION > 4
+        CallFunction->ChildProperties
+#else
+        CallFunction->Children
+#endif
+    );
+    uint8* ReturnValueAddress = CallFunction->ReturnValueOffset != MAX_uint16 ? Params + CallFunction->ReturnValueOffset : nullptr;
+    CallFunction->Invoke(CallObject, NewStack, ReturnValueAddress);
+
+    if (FastCallReturn.Property)
+    {
+        const void* ReturnPtr = Params + FastCallReturn.Offset;
+        switch (FastCallReturn.Type)
+        {
+            case EFastCallType::Bool:
+                Result.BoolValue = static_cast<BoolPropertyMacro*>(FastCallReturn.Property)->GetPropertyValue(ReturnPtr);
+                break;
+            case EFastCallType::Int32:
+                Result.Int32Value = static_cast<int32>(
+                    static_cast<NumericPropertyMacro*>(FastCallReturn.Property)->GetSignedIntPropertyValue(ReturnPtr));
+                break;
+            case EFastCallType::Float64:
+                Result.Float64Value =
+                    static_cast<NumericPropertyMacro*>(FastCallReturn.Property)->GetFloatingPointPropertyValue(ReturnPtr);
+                break;
+            default:
+                break;
+        }
+    }
+    return true;
 }
+#endif
 
 v8::Local<v8::FunctionTemplate> FFunctionTranslator::ToFunctionTemplate(v8::Isolate* Isolate)
 {
+#if PUERTS_REFLECTED_FAST_CALL
+    if (FastCallEnabled)
+    {
+        return v8::FunctionTemplate::New(Isolate, Call, v8::External::New(Isolate, this), v8::Local<v8::Signature>(), 0,
+            v8::ConstructorBehavior::kAllow, v8::SideEffectType::kHasSideEffect, &FastCallFunction);
+    }
+#endif
     return v8::FunctionTemplate::New(Isolate, Call, v8::External::New(Isolate, this));
 }
 
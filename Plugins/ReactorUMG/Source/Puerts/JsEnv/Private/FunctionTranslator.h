@@ -25,13 +25,36 @@ PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
 #pragma warning(pop)
 PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
 
+// FastApiCallbackOptions::data, used to find the translator of a fast call, needs v8 10+
+#if !defined(WITH_QUICKJS) && defined(V8_MAJOR_VERSION) && V8_MAJOR_VERSION >= 10
+#define PUERTS_REFLECTED_FAST_CALL 1
+#pragma warning(push, 0)
+#include "v8-fast-api-calls.h"
+#pragma warning(pop)
+#else
+#define PUERTS_REFLECTED_FAST_CALL 0
+#endif
+
 namespace PUERTS_NAMESPACE
 {
+#if PUERTS_REFLECTED_FAST_CALL
+template <typename Ret, typename Indices>
+struct TReflectedFastCall;
+#endif
+
 class FFunctionTranslator
 {
 public:
     explicit FFunctionTranslator(UFunction* InFunction, bool IsDelegate);
 
+    /**
+     * Lets JS call a native UFunction through V8's fast API once TurboFan optimized the caller, skipping the
+     * FunctionCallbackInfo, the param buffer memzero and the param iteration. Only used while the parameters are all
+     * numbers, bools, enums and UObject pointers, and the return value is void, a number, a bool or an enum.
+     * The function must not call into JS, so it is opt-in, and has to be added before its class is first used from JS
+     */
+    static void AddFastCallFunction(UFunction* InFunction);
+
     virtual ~FFunctionTranslator()
     {
         if (ArgumentDefaultValues)
@@ -117,6 +140,30 @@ protected:
 #if WITH_EDITOR
     FName FunctionName;
 #endif
+#if PUERTS_REFLECTED_FAST_CALL
+    enum class EFastCallType : uint8
+    {
+        None,
+        Bool,
+        Int32,
+        Float64,
+        Object,
+    };
+
+    struct FFastCallParam
+    {
+        PropertyMacro* Property;
+        int32 Offset;
+        EFastCallType Type;
+    };
+
+    union FFastCallResult
+    {
+        bool BoolValue;
+        int32 Int32Value;
+        double Float64Value;
+    };
+#endif
 private:
     static void Call(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
@@ -130,6 +177,32 @@ private:
 
     void Init(UFunction* InFunction, bool IsDelegate);
 
+#if PUERTS_REFLECTED_FAST_CALL
+    void InitFastCall(UFunction* InFunction, bool IsDelegate);
+
+    /**
+     * @return false to fall back to the slow callback, before anything was called
+     */
+    bool CallFast(v8::Local<v8::Object> Receiver, const v8::Local<v8::Value>* Args, int ArgCount, FFastCallResult& Result);
+
+    std::vector<FFastCallParam> FastCallParams;
+
+    bool FastCallEnabled = false;
+
+    // built once, the function templates created from this translator keep pointing at it
+    std::unique_ptr<v8::CFunctionInfo> FastCallInfo;
+
+    std::vector<v8::CTypeInfo> FastCallArgInfos;
+
+    v8::CFunction FastCallFunction;
+
+    // Property is null for void, the underlying property of an enum is only used on the value at Offset
+    FFastCallParam FastCallReturn{nullptr, 0, EFastCallType::None};
+
+    template <typename Ret, typename Indices>
+    friend struct TReflectedFastCall;
+#endif
+
     friend class FStructWrapper;
     friend class FJsEnvImpl;
 };
@@ -8,6 +8,7 @@
 
 #include "JsEnv.h"
 #include "JsEnvImpl.h"
+#include "FunctionTranslator.h"
 
 namespace PUERTS_NAMESPACE
 {
@@ -18,10 +19,10 @@ FJsEnv::FJsEnv(const FString& ScriptRoot)
 
 FJsEnv::FJsEnv(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::shared_ptr<ILogger> InLogger, int InDebugPort,
     std::function<void(const FString&)> InOnSourceLoadedCallback, const FString InFlags, void* InExternalRuntime,
-    void* InExternalContext)
+    void* InExternalContext, std::shared_ptr<const TArray<uint8>> InSnapshotBlob)
 {
-    GameScript = std::make_unique<FJsEnvImpl>(
-        std::move(InModuleLoader), InLogger, InDebugPort, InOnSourceLoadedCallback, InFlags, InExternalRuntime, InExternalContext);
+    GameScript = std::make_unique<FJsEnvImpl>(std::move(InModuleLoader), InLogger, InDebugPort, InOnSourceLoadedCallback, InFlags,
+        InExternalRuntime, InExternalContext, std::move(InSnapshotBlob));
 }
 
 void FJsEnv::Start(const FString& ModuleName, const TArray<TPair<FString, UObject*>>& Arguments)
@@ -100,4 +101,9 @@ void FJsEnv::ForceReloadJsFile(const FString& ModuleName)
 {
     GameScript->ForceReloadJsFile(ModuleName);
 }
+
+void FJsEnv::AddFastCallFunction(UFunction* Function)
+{
+    FFunctionTranslator::AddFastCallFunction(Function);
+}
 }    // namespace PUERTS_NAMESPACE
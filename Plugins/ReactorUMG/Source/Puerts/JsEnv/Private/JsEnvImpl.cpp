@@ -8,6 +8,7 @@
 
 #include "JsEnvImpl.h"
 #include "JsEnvModule.h"
+#include "JsEnvSnapshot.h"
 #include "DynamicDelegateProxy.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
@@ -18,6 +19,7 @@
 #include "V8Utils.h"
 #include "ObjectMapper.h"
 #include "JSLogger.h"
+#include "PuertsStats.h"
 #if !defined(ENGINE_INDEPENDENT_JSENV)
 #include "JSGeneratedClass.h"
 #include "JSWidgetGeneratedClass.h"
@@ -90,6 +92,11 @@ PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
 void InitWebsocketPPWrap(v8::Local<v8::Context> Context);
 #endif
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Live Delegates"), STAT_PuertsLiveDelegates, STATGROUP_Puerts);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Delegate Owners"), STAT_PuertsDelegateOwners, STATGROUP_Puerts);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cleared Delegates"), STAT_PuertsClearedDelegates, STATGROUP_Puerts);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("JS Callback Signatures"), STAT_PuertsJsCallbackSignatures, STATGROUP_Puerts);
+
 namespace PUERTS_NAMESPACE
 {
 #if !defined(WITH_QUICKJS)
@@ -330,7 +337,7 @@ void FJsEnvImpl::StopPolling()
 
 #endif
 
-#if defined(WITH_V8_BYTECODE)
+#if !defined(WITH_QUICKJS)
 struct FCodeCacheHeader
 {
     uint32_t MagicNumber;
@@ -347,7 +354,7 @@ struct FCodeCacheHeader
 
 FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::shared_ptr<ILogger> InLogger, int InDebugPort,
     std::function<void(const FString&)> InOnSourceLoadedCallback, const FString InFlags, void* InExternalRuntime,
-    void* InExternalContext)
+    void* InExternalContext, std::shared_ptr<const TArray<uint8>> InSnapshotBlob)
 {
     GUObjectArray.AddUObjectDeleteListener(static_cast<FUObjectArray::FUObjectDeleteListener*>(this));
 
@@ -388,6 +395,23 @@ FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::sha
 #endif
 
     CreateParams.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+#if !defined(WITH_QUICKJS) && V8_MAJOR_VERSION >= 9
+    if (InSnapshotBlob && InSnapshotBlob->Num() > 0)
+    {
+        SnapshotStartupData.data = reinterpret_cast<const char*>(InSnapshotBlob->GetData());
+        SnapshotStartupData.raw_size = InSnapshotBlob->Num();
+        if (SnapshotStartupData.IsValid())
+        {
+            // the default context of the blob already holds the preloaded modules, see FJsEnvSnapshot
+            SnapshotBlob = InSnapshotBlob;
+            CreateParams.snapshot_blob = &SnapshotStartupData;
+        }
+        else
+        {
+            Logger->Warn(TEXT("startup snapshot was not created by this V8 build, booting without it"));
+        }
+    }
+#endif
 #ifdef WITH_QUICKJS
     MainIsolate = InExternalRuntime ? v8::Isolate::New(InExternalRuntime) : v8::Isolate::New(CreateParams);
 #else
@@ -399,6 +423,9 @@ FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::sha
     v8::Locker Locker(Isolate);
 #endif
     Isolate->SetData(0, static_cast<IObjectMapper*>(this));    //直接传this会有问题，强转后地址会变
+#if !defined(WITH_QUICKJS)
+    StringCache.Attach(Isolate);
+#endif
 
     v8::Isolate::Scope Isolatescope(Isolate);
     v8::HandleScope HandleScope(Isolate);
@@ -434,6 +461,9 @@ FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::sha
     v8::Locker Locker(Isolate);
 #endif
     Isolate->SetData(0, static_cast<IObjectMapper*>(this));    //直接传this会有问题，强转后地址会变
+#if !defined(WITH_QUICKJS)
+    StringCache.Attach(Isolate);
+#endif
 
     // v8::Locker locker(Isolate);
     // difference from embedding example, if lock, blow check fail:
@@ -625,6 +655,10 @@ FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::sha
 
     ExecuteModule("puerts/first_run.js");
 #if !defined(WITH_NODEJS)
+    // the same NODE_ENV the startup snapshot was built with
+    PuertsObj
+        ->Set(Context, FV8Utils::ToV8String(Isolate, "nodeEnv"), FV8Utils::ToV8String(Isolate, FJsEnvSnapshot::GetNodeEnv()))
+        .Check();
     ExecuteModule("puerts/polyfill.js");
 #endif
     ExecuteModule("puerts/log.js");
@@ -663,6 +697,8 @@ FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::sha
     DelegateProxiesCheckerHandler =
         FUETicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FJsEnvImpl::CheckDelegateProxies), 1);
 
+    TimerTickerHandle = FUETicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FJsEnvImpl::TickTimers));
+
     ManualReleaseCallbackMap.Reset(Isolate, v8::Map::New(Isolate));
 
     UserObjectRetainer.SetName(TEXT("Puerts_UserObjectRetainer"));
@@ -678,7 +714,7 @@ FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::sha
     PuertsWasmRuntimeList.Add(std::make_shared<WasmRuntime>(PuertsWasmEnv.get()));
     ExecuteModule("puerts/wasm3_helper.js");
 #endif
-#if defined(WITH_V8_BYTECODE)
+#if !defined(WITH_QUICKJS)
     auto Script = v8::Script::Compile(Context, FV8Utils::ToV8String(Isolate, "")).ToLocalChecked();
     auto CachedCode = v8::ScriptCompiler::CreateCodeCache(Script->GetUnboundScript());
     const FCodeCacheHeader* CodeCacheHeader = (const FCodeCacheHeader*) CachedCode->data;
@@ -689,6 +725,8 @@ FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::sha
 #if !WITH_EDITOR
     delete CachedCode;    //编辑器下是v8.dll分配的，ue里的delete被重载了，这delete会有问题
 #endif
+    // code caches of plain .js/.mjs modules, written on first compile and consumed on later launches
+    CodeCacheStore.Initialize(FPaths::ProjectSavedDir() / TEXT("PuertsCodeCache"), Expect_FlagHash);
 #endif
 
 #if defined(WITH_WEBSOCKET)
@@ -729,6 +767,7 @@ FJsEnvImpl::~FJsEnvImpl()
     }
     HashToModuleInfo.clear();
     PathToModule.Empty();
+    PendingCodeCaches.clear();
 #endif
 
     for (int i = 0; i < ManualReleaseCallbackList.size(); i++)
@@ -747,6 +786,7 @@ FJsEnvImpl::~FJsEnvImpl()
     ForceReloadJs.Reset();
 
     FUETicker::GetCoreTicker().RemoveTicker(DelegateProxiesCheckerHandler);
+    FUETicker::GetCoreTicker().RemoveTicker(TimerTickerHandle);
 
     {
         auto Isolate = MainIsolate;
@@ -762,6 +802,12 @@ FJsEnvImpl::~FJsEnvImpl()
 
         ObjectMap.Empty();
 
+        // the cached shapes hold the keys of js objects
+        ObjectMergers.clear();
+#if !defined(WITH_QUICKJS)
+        StringCache.Detach(Isolate);
+#endif
+
         for (auto& KV : StructCache)
         {
             FObjectCacheNode* PNode = &KV.Value;
@@ -829,9 +875,9 @@ FJsEnvImpl::~FJsEnvImpl()
         for (auto Iter = TimerInfos.CreateIterator(); Iter; ++Iter)
         {
             Iter->Value.Callback.Reset();
-            FUETicker::GetCoreTicker().RemoveTicker(Iter->Value.TickerHandle);
         }
         TimerInfos.Empty();
+        TimerWheel.Reset();
 
 #if !defined(ENGINE_INDEPENDENT_JSENV)
         for (auto& GeneratedClass : GeneratedClasses)
@@ -1799,13 +1845,14 @@ void FJsEnvImpl::Bind(FClassWrapper* ClassWrapper, UObject* UEObject,
 void FJsEnvImpl::SetJsTakeRef(UObject* UEObject, FClassWrapper* ClassWrapper)
 {
     UserObjectRetainer.Retain(UEObject);
-    ObjectMap[UEObject].SetWeak<UClass>(
+    ObjectMap.Find(UEObject)->SetWeak<UClass>(
         Cast<UClass>(ClassWrapper->Struct.Get()), FClassWrapper::OnGarbageCollected, v8::WeakCallbackType::kInternalFields);
 }
 
 void FJsEnvImpl::UnBind(UClass* Class, UObject* UEObject, bool ResetPointer)
 {
-    auto PersistentValuePtr = ObjectMap.Find(UEObject);
+    // also called by NotifyUObjectDeleted, once the serial number of the object may be gone
+    auto PersistentValuePtr = ObjectMap.FindDeleting(UEObject);
     if (PersistentValuePtr)
     {
         if (ResetPointer)
@@ -1953,6 +2000,10 @@ v8::Local<v8::Value> FJsEnvImpl::FindOrAddDelegate(v8::Isolate* Isolate, v8::Loc
         DelegateMap[DelegatePtr] = {v8::UniquePersistent<v8::Object>(Isolate, JSObject), TWeakObjectPtr<UObject>(Owner),
             DelegateProperty, MulticastDelegateProperty, Function, PassByPointer, nullptr,
             v8::UniquePersistent<v8::Array>(Isolate, v8::Array::New(Isolate))};
+        if (Owner)
+        {
+            DelegatesByOwner.FindOrAdd(Owner).Add(DelegatePtr);
+        }
         return JSObject;
     }
 }
@@ -2164,6 +2215,14 @@ void FJsEnvImpl::NotifyUObjectDeleted(const class UObjectBase* ObjectBase, int32
 
     TsFunctionMap.Remove((UFunction*) ObjectBase);
     MixinFunctionMap.Remove((UFunction*) ObjectBase);
+    JsCallbackPrototypeMap.erase((UFunction*) ObjectBase);
+
+    // the owner memory is gone already, the delegates are cleared on the next tick
+    TArray<void*> OwnedDelegates;
+    if (DelegatesByOwner.RemoveAndCopyValue(ObjectBase, OwnedDelegates))
+    {
+        PendingClearDelegates.Append(OwnedDelegates);
+    }
     ContainerMeta.NotifyElementTypeDeleted((UField*) ObjectBase);
 
     auto CallbacksPtr = AutoReleaseCallbacksMap.Find((UObject*) ObjectBase);
@@ -2800,51 +2859,70 @@ bool FJsEnvImpl::CheckDelegateProxies(float Tick)
     v8::Locker Locker(Isolate);
 #endif
 
-    std::vector<void*> PendingToRemove;
-    for (auto& KV : DelegateMap)
-    {
-        if (!KV.second.Owner.IsValid())
-        {
-            PendingToRemove.push_back(KV.first);
-        }
-    }
+    SweepDelegateProxies();
 
-    if (PendingToRemove.size() > 0)
+    if (PendingClearDelegates.Num() > 0)
     {
         v8::Isolate::Scope IsolateScope(Isolate);
         v8::HandleScope HandleScope(Isolate);
         v8::Local<v8::Context> Context = DefaultContext.Get(Isolate);
         v8::Context::Scope ContextScope(Context);
-        for (int i = 0; i < PendingToRemove.size(); ++i)
+        int32 ClearedDelegates = 0;
+        for (void* DelegatePtr : PendingClearDelegates)
         {
-            ClearDelegate(Isolate, Context, PendingToRemove[i]);
-            if (!DelegateMap[PendingToRemove[i]].PassByPointer)
+            // removed already, or the address was reused by a delegate of a live owner
+            auto Iter = DelegateMap.find(DelegatePtr);
+            if (Iter == DelegateMap.end() || Iter->second.Owner.IsValid())
             {
-                delete ((FScriptDelegate*) PendingToRemove[i]);
+                continue;
+            }
+
+            ClearDelegate(Isolate, Context, DelegatePtr);
+            if (!Iter->second.PassByPointer)
+            {
+                delete ((FScriptDelegate*) DelegatePtr);
             }
-            DelegateMap.erase(PendingToRemove[i]);
+            DelegateMap.erase(Iter);
+            ++ClearedDelegates;
         }
+        PendingClearDelegates.Reset();
+        INC_DWORD_STAT_BY(STAT_PuertsClearedDelegates, ClearedDelegates);
     }
 
-    // Collecting invalid function translators to remove.
-    std::vector<UFunction*> PendingToRemoveJsCallbacks;
-    for (auto& KV : JsCallbackPrototypeMap)
+    SET_DWORD_STAT(STAT_PuertsLiveDelegates, DelegateMap.size());
+    SET_DWORD_STAT(STAT_PuertsDelegateOwners, DelegatesByOwner.Num());
+    SET_DWORD_STAT(STAT_PuertsJsCallbackSignatures, JsCallbackPrototypeMap.size());
+    return true;
+}
+
+void FJsEnvImpl::SweepDelegateProxies()
+{
+    constexpr double SweepBudgetSeconds = 0.0002;
+    constexpr size_t DelegatesPerTimeCheck = 64;
+
+    const double EndTime = FPlatformTime::Seconds() + SweepBudgetSeconds;
+    // DelegateMap is ordered by address, a delegate removed since is skipped over
+    auto Iter = DelegateMap.upper_bound(DelegateSweepCursor);
+    for (size_t Checked = 1; Checked <= DelegateMap.size(); ++Checked)
     {
-        if ((nullptr == KV.first) || (!KV.second->IsValid()))
+        if (Iter == DelegateMap.end())
         {
-            PendingToRemoveJsCallbacks.push_back(KV.first);
+            DelegateSweepCursor = nullptr;
+            return;
         }
-    }
 
-    if (PendingToRemoveJsCallbacks.size() > 0)
-    {
-        for (int32 i = 0; i < PendingToRemoveJsCallbacks.size(); i++)
+        if (!Iter->second.Owner.IsValid())
         {
-            JsCallbackPrototypeMap.erase(PendingToRemoveJsCallbacks[i]);
+            PendingClearDelegates.Add(Iter->first);
         }
-    }
+        DelegateSweepCursor = Iter->first;
+        ++Iter;
 
-    return true;
+        if (Checked % DelegatesPerTimeCheck == 0 && FPlatformTime::Seconds() > EndTime)
+        {
+            return;
+        }
+    }
 }
 
 FPropertyTranslator* FJsEnvImpl::GetContainerPropertyTranslator(PropertyMacro* Property)
@@ -3586,6 +3664,9 @@ void FJsEnvImpl::Start(const FString& ModuleNameOrScript, const TArray<TPair<FSt
         Logger->Error(FV8Utils::TryCatchToString(Isolate, &TryCatch));
     }
 
+#ifndef WITH_QUICKJS
+    SavePendingCodeCaches();
+#endif
     Started = true;
 }
 
@@ -3745,6 +3826,9 @@ v8::MaybeLocal<v8::Module> FJsEnvImpl::FetchESModuleTree(v8::Local<v8::Context>
 
     v8::ScriptCompiler::CachedData* CachedCode = nullptr;
     v8::ScriptCompiler::CompileOptions Options = v8::ScriptCompiler::CompileOptions::kNoCompileOptions;
+    bool UsePersistentCodeCache = false;
+    uint64 SourceHash = 0;
+    TArray<uint8> PersistentCodeCache;
 #if defined(WITH_V8_BYTECODE)
     if (FileName.EndsWith(TEXT(".mbc")))
     {
@@ -3781,6 +3865,18 @@ v8::MaybeLocal<v8::Module> FJsEnvImpl::FetchESModuleTree(v8::Local<v8::Context>
         FString Script;
         FFileHelper::BufferToString(Script, Data.GetData(), Data.Num());
         Source = FV8Utils::ToV8String(Isolate, Script);
+
+        UsePersistentCodeCache = CodeCacheStore.IsEnabled();
+        if (UsePersistentCodeCache)
+        {
+            SourceHash = FCodeCacheStore::HashSource(Data.GetData(), Data.Num());
+            if (CodeCacheStore.Load(FileName, SourceHash, PersistentCodeCache))
+            {
+                CachedCode = new v8::ScriptCompiler::CachedData(
+                    PersistentCodeCache.GetData(), PersistentCodeCache.Num());    // will delete by ~Source
+                Options = v8::ScriptCompiler::CompileOptions::kConsumeCodeCache;
+            }
+        }
     }
 
 #if V8_MAJOR_VERSION > 8
@@ -3799,6 +3895,13 @@ v8::MaybeLocal<v8::Module> FJsEnvImpl::FetchESModuleTree(v8::Local<v8::Context>
         return v8::MaybeLocal<v8::Module>();
     }
 
+    if (UsePersistentCodeCache && (!CachedCode || CachedCode->rejected))
+    {
+        FPendingCodeCache PendingCodeCache{FileName, SourceHash};
+        PendingCodeCache.ModuleScript.Reset(Isolate, Module->GetUnboundModuleScript());
+        PendingCodeCaches.push_back(std::move(PendingCodeCache));
+    }
+
     PathToModule.Add(FileName, v8::Global<v8::Module>(Isolate, Module));
     FModuleInfo* Info = new FModuleInfo;
     Info->Module.Reset(Isolate, Module);
@@ -3873,6 +3976,23 @@ v8::MaybeLocal<v8::Module> FJsEnvImpl::FetchESModuleTree(v8::Local<v8::Context>
 }
 #endif
 
+#ifndef WITH_QUICKJS
+void FJsEnvImpl::SavePendingCodeCaches()
+{
+    v8::Isolate* Isolate = MainIsolate;
+    v8::HandleScope HandleScope(Isolate);
+    for (FPendingCodeCache& PendingCodeCache : PendingCodeCaches)
+    {
+        v8::ScriptCompiler::CachedData* CachedData =
+            PendingCodeCache.Script.IsEmpty()
+                ? v8::ScriptCompiler::CreateCodeCache(PendingCodeCache.ModuleScript.Get(Isolate))
+                : v8::ScriptCompiler::CreateCodeCache(PendingCodeCache.Script.Get(Isolate));
+        CodeCacheStore.Save(PendingCodeCache.Path, PendingCodeCache.SourceHash, CachedData);
+    }
+    PendingCodeCaches.clear();
+}
+#endif
+
 void FJsEnvImpl::ExecuteModule(const FString& ModuleName)
 {
     FString OutPath;
@@ -3997,6 +4117,10 @@ void FJsEnvImpl::EvalScript(const v8::FunctionCallbackInfo<v8::Value>& Info)
                     }
                 }
                 Info.GetReturnValue().Set(RootModule->GetModuleNamespace());
+                if (Started)
+                {
+                    SavePendingCodeCaches();
+                }
             }
         }
 
@@ -4020,10 +4144,11 @@ void FJsEnvImpl::EvalScript(const v8::FunctionCallbackInfo<v8::Value>& Info)
 #endif
     v8::Local<v8::String> Source = Info[0]->ToString(Context).ToLocalChecked();
 
-#if defined(WITH_V8_BYTECODE)
+#if !defined(WITH_QUICKJS)
     v8::ScriptCompiler::CachedData* CachedCode = nullptr;
-    uint8_t* Cache = nullptr;
     v8::ScriptCompiler::CompileOptions Options = v8::ScriptCompiler::CompileOptions::kNoCompileOptions;
+#if defined(WITH_V8_BYTECODE)
+    uint8_t* Cache = nullptr;
     if (Info.Length() > 4)
     {
         if (Info[4]->IsArrayBuffer())
@@ -4043,10 +4168,36 @@ void FJsEnvImpl::EvalScript(const v8::FunctionCallbackInfo<v8::Value>& Info)
             }
         }
     }
+#endif
+
+    // .cbc bytecode carries its own cache, plain sources go through the persistent one
+    const bool UsePersistentCodeCache = !CachedCode && CodeCacheStore.IsEnabled();
+    uint64 SourceHash = 0;
+    TArray<uint8> PersistentCodeCache;
+    if (UsePersistentCodeCache)
+    {
+        SourceHash = FCodeCacheStore::HashSource(Isolate, Source);
+        if (CodeCacheStore.Load(ScriptUrl, SourceHash, PersistentCodeCache))
+        {
+            CachedCode = new v8::ScriptCompiler::CachedData(
+                PersistentCodeCache.GetData(), PersistentCodeCache.Num());    // will delete by ~Source
+            Options = v8::ScriptCompiler::CompileOptions::kConsumeCodeCache;
+        }
+    }
 
     v8::ScriptCompiler::Source ScriptSource(Source, Origin, CachedCode);
     auto Script = v8::ScriptCompiler::Compile(Context, &ScriptSource, Options);
-    if (CachedCode)
+    if (UsePersistentCodeCache)
+    {
+        if (!Script.IsEmpty() && (!CachedCode || CachedCode->rejected))
+        {
+            FPendingCodeCache PendingCodeCache{ScriptUrl, SourceHash};
+            PendingCodeCache.Script.Reset(Isolate, Script.ToLocalChecked()->GetUnboundScript());
+            PendingCodeCaches.push_back(std::move(PendingCodeCache));
+        }
+    }
+#if defined(WITH_V8_BYTECODE)
+    else if (CachedCode)
     {
         delete Cache;
         if (CachedCode->rejected)
@@ -4055,6 +4206,7 @@ void FJsEnvImpl::EvalScript(const v8::FunctionCallbackInfo<v8::Value>& Info)
             return;
         }
     }
+#endif
 #else
     auto Script = v8::Script::Compile(Context, Source, &Origin);
 #endif
@@ -4069,6 +4221,13 @@ void FJsEnvImpl::EvalScript(const v8::FunctionCallbackInfo<v8::Value>& Info)
         return;
     }
     Info.GetReturnValue().Set(Result.ToLocalChecked());
+#ifndef WITH_QUICKJS
+    // scripts run during startup are saved once Start is done, later ones as soon as they have run
+    if (Started)
+    {
+        SavePendingCodeCaches();
+    }
+#endif
 
     if (OnSourceLoadedCallback)
     {
@@ -4163,10 +4322,10 @@ void FJsEnvImpl::SetTimeout(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     CHECK_V8_ARGS(EArgFunction, EArgNumber);
 
-    SetFTickerDelegate(Info, false);
+    AddTimer(Info, false);
 }
 
-void FJsEnvImpl::SetFTickerDelegate(const v8::FunctionCallbackInfo<v8::Value>& Info, bool Continue)
+void FJsEnvImpl::AddTimer(const v8::FunctionCallbackInfo<v8::Value>& Info, bool Continue)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -4178,23 +4337,30 @@ void FJsEnvImpl::SetFTickerDelegate(const v8::FunctionCallbackInfo<v8::Value>& I
     FTimerInfo& TimerInfo = TimerInfos.Emplace(DelegateHandleId, FTimerInfo());
     TimerInfo.Callback.Reset(Isolate, v8::Local<v8::Function>::Cast(Info[0]));
 
-    float Millisecond = Info[1]->NumberValue(Context).ToChecked();
-    float Delay = Millisecond / 1000.f;
+    // NaN and negative delays fire on the next tick
+    double Millisecond = Info[1]->NumberValue(Context).ToChecked();
+    TimerInfo.Continue = Continue;
+    TimerInfo.Interval = Millisecond > 0 ? static_cast<uint64>(FMath::Min(Millisecond, static_cast<double>(MAX_uint32))) : 0;
 
-    TimerInfo.TickerHandle =
-        FUETicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this, DelegateHandleId, Continue](float)
-                                                 { return this->TimerCallback(DelegateHandleId, Continue); }),
-            Delay);
+    TimerWheel.Add(DelegateHandleId, TimerWheel.GetTime() + TimerInfo.Interval);
 
     Info.GetReturnValue().Set(DelegateHandleId);
 }
 
-bool FJsEnvImpl::TimerCallback(int DelegateHandleId, bool Continue)
+bool FJsEnvImpl::TickTimers(float DeltaTime)
 {
-    v8::Isolate* Isolate = MainIsolate;
 #ifdef SINGLE_THREAD_VERIFY
     ensureMsgf(BoundThreadId == FPlatformTLS::GetCurrentThreadId(), TEXT("Access by illegal thread!"));
 #endif
+    TimerSeconds += DeltaTime;
+    DueTimers.Reset();
+    TimerWheel.Advance(static_cast<uint64>(TimerSeconds * 1000.0), DueTimers);
+    if (DueTimers.Num() == 0)
+    {
+        return true;
+    }
+
+    v8::Isolate* Isolate = MainIsolate;
 #ifdef THREAD_SAFE
     v8::Locker Locker(MainIsolate);
 #endif
@@ -4204,43 +4370,53 @@ bool FJsEnvImpl::TimerCallback(int DelegateHandleId, bool Continue)
     v8::Local<v8::Context> Context = DefaultContext.Get(Isolate);
     v8::Context::Scope ContextScope(Context);
 
-    FTimerInfo* PTimeInfo = TimerInfos.Find(DelegateHandleId);
-    if (!PTimeInfo)
     {
-        Logger->Warn(FString::Printf(TEXT("Try to callback a invalid timer: %d"), DelegateHandleId));
-        return false;
-    }
-
-    auto OriginHandle = PTimeInfo->TickerHandle;
-    v8::Local<v8::Function> Function = TimerInfos[DelegateHandleId].Callback.Get(Isolate);
+#if !defined(WITH_QUICKJS)
+        v8::Isolate::SuppressMicrotaskExecutionScope SuppressMicrotasks(Isolate);
+#endif
+        for (const FTimerWheel::FDueTimer& DueTimer : DueTimers)
+        {
+            // cleared since it was added
+            FTimerInfo* PTimeInfo = TimerInfos.Find(DueTimer.Id);
+            if (!PTimeInfo)
+            {
+                continue;
+            }
 
-    v8::TryCatch TryCatch(Isolate);
-    (void) (Function->Call(Context, Context->Global(), 0, nullptr));
+            v8::Local<v8::Function> Function = PTimeInfo->Callback.Get(Isolate);
+            if (!PTimeInfo->Continue)
+            {
+                TimerInfos.Remove(DueTimer.Id);
+            }
 
-    if (TryCatch.HasCaught())
-    {
-        FString Message =
-            FString::Printf(TEXT("Exception in Timer Callback: %s"), *(FV8Utils::TryCatchToString(Isolate, &TryCatch)));
-        Logger->Error(Message);
-    }
+            v8::TryCatch TryCatch(Isolate);
+            (void) (Function->Call(Context, Context->Global(), 0, nullptr));
 
-    auto ClearInCallback = !TimerInfos.Contains(DelegateHandleId) || (OriginHandle != TimerInfos[DelegateHandleId].TickerHandle);
+            if (TryCatch.HasCaught())
+            {
+                FString Message = FString::Printf(
+                    TEXT("Exception in Timer Callback: %s"), *(FV8Utils::TryCatchToString(Isolate, &TryCatch)));
+                Logger->Error(Message);
+            }
 
-    if (!Continue && !ClearInCallback)
-    {
-        RemoveFTickerDelegateHandle(DelegateHandleId);
+            // the callback may have cleared the interval, or added timers and moved the map
+            PTimeInfo = TimerInfos.Find(DueTimer.Id);
+            if (PTimeInfo && PTimeInfo->Continue)
+            {
+                TimerWheel.Add(DueTimer.Id, TimerWheel.GetTime() + PTimeInfo->Interval);
+            }
+        }
     }
+#if !defined(WITH_QUICKJS)
+    Isolate->PerformMicrotaskCheckpoint();
+#endif
 
-    return Continue && !ClearInCallback;
+    DueTimers.Reset();
+    return true;
 }
 
-void FJsEnvImpl::RemoveFTickerDelegateHandle(int DelegateHandleId)
+void FJsEnvImpl::RemoveTimer(int DelegateHandleId)
 {
-    if (!TimerInfos.Contains(DelegateHandleId))
-    {
-        return;
-    }
-    FUETicker::GetCoreTicker().RemoveTicker(TimerInfos[DelegateHandleId].TickerHandle);
     TimerInfos.Remove(DelegateHandleId);
 }
 
@@ -4263,7 +4439,7 @@ void FJsEnvImpl::ClearInterval(const v8::FunctionCallbackInfo<v8::Value>& Info)
     {
         CHECK_V8_ARGS(EArgInt32);
         int HandleId = Info[0]->Int32Value(Context).ToChecked();
-        RemoveFTickerDelegateHandle(HandleId);
+        RemoveTimer(HandleId);
     }
 }
 
@@ -4277,7 +4453,7 @@ void FJsEnvImpl::SetInterval(const v8::FunctionCallbackInfo<v8::Value>& Info)
 
     CHECK_V8_ARGS(EArgFunction, EArgNumber);
 
-    SetFTickerDelegate(Info, true);
+    AddTimer(Info, true);
 }
 
 #if !defined(ENGINE_INDEPENDENT_JSENV)
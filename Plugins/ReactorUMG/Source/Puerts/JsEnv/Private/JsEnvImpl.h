@@ -22,6 +22,10 @@
 #include "UECompatible.h"
 #include "ContainerMeta.h"
 #include "ObjectCacheNode.h"
+#include "CodeCacheStore.h"
+#include "TimerWheel.h"
+#include "ObjectHandleTable.h"
+#include "V8StringCache.h"
 #include <unordered_map>
 
 #if ENGINE_MINOR_VERSION >= 25 || ENGINE_MAJOR_VERSION > 4
@@ -82,7 +86,7 @@ public:
 
     FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::shared_ptr<ILogger> InLogger, int InPort,
         std::function<void(const FString&)> InOnSourceLoadedCallback, const FString InFlags, void* InExternalRuntime,
-        void* InExternalContext);
+        void* InExternalContext, std::shared_ptr<const TArray<uint8>> InSnapshotBlob = nullptr);
 
     virtual ~FJsEnvImpl() override;
 
@@ -234,6 +238,10 @@ public:
 
     bool CheckDelegateProxies(float Tick);
 
+    // queues the delegates with an invalid owner the delete listener missed, like the ones without an owner, a slice of
+    // DelegateMap per tick
+    void SweepDelegateProxies();
+
     virtual v8::Local<v8::Value> CreateArray(
         v8::Isolate* Isolate, v8::Local<v8::Context>& Context, FPropertyTranslator* Property, void* ArrayPtr) override;
 
@@ -318,11 +326,12 @@ private:
 
     void SetTimeout(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
-    void SetFTickerDelegate(const v8::FunctionCallbackInfo<v8::Value>& Info, bool Continue);
+    void AddTimer(const v8::FunctionCallbackInfo<v8::Value>& Info, bool Continue);
 
-    bool TimerCallback(int DelegateHandleId, bool Continue);
+    // fires the expired timers in one batch, the microtasks queued by them run once after the batch
+    bool TickTimers(float DeltaTime);
 
-    void RemoveFTickerDelegateHandle(int HandleId);
+    void RemoveTimer(int HandleId);
 
     void SetInterval(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
@@ -380,10 +389,50 @@ private:
 
     struct ObjectMerger
     {
-        std::map<PString, std::unique_ptr<FPropertyTranslator>> Fields;
+        // lets a key written to a stack buffer look up Fields without building a PString
+        struct FNameLess
+        {
+            using is_transparent = void;
+
+            bool operator()(const PString& A, const PString& B) const
+            {
+                return std::strcmp(A.c_str(), B.c_str()) < 0;
+            }
+            bool operator()(const PString& A, const char* B) const
+            {
+                return std::strcmp(A.c_str(), B) < 0;
+            }
+            bool operator()(const char* A, const PString& B) const
+            {
+                return std::strcmp(A, B.c_str()) < 0;
+            }
+        };
+
+        std::map<PString, std::unique_ptr<FPropertyTranslator>, FNameLess> Fields;
         UStruct* Struct;
         FJsEnvImpl* Parent;
 
+        // Translator is null if the key is not a property of Struct
+        struct FResolvedField
+        {
+            FPropertyTranslator* Translator;
+            ObjectMerger* FieldMerger;
+        };
+
+        struct FKeyField
+        {
+            v8::Global<v8::String> Key;
+            FResolvedField Field;
+        };
+
+        // resolved fields by property key, whatever the layout of the object holding them. V8 internalizes named
+        // property keys, so every object hands back the very same key string: a key seen once is found by identity
+        // hash and handle compare, without a utf8 conversion or an allocation
+        std::unordered_multimap<int, FKeyField> KeyFields;
+
+        // keys beyond this are resolved again on every merge instead of being cached
+        static constexpr size_t MaxCachedKeys = 512;
+
         ObjectMerger(FJsEnvImpl* InParent, UStruct* InStruct)
         {
             Parent = InParent;
@@ -396,6 +445,59 @@ private:
             }
         }
 
+        FResolvedField ResolveField(v8::Isolate* Isolate, v8::Local<v8::String> Key)
+        {
+            FResolvedField Field{nullptr, nullptr};
+            // longer than any property name
+            char Name[256];
+            if (Key->Utf8Length(Isolate) >= static_cast<int>(sizeof(Name)))
+            {
+                return Field;
+            }
+            Key->WriteUtf8(Isolate, Name, sizeof(Name));
+
+            auto Iter = Fields.find(static_cast<const char*>(Name));
+            if (Iter == Fields.end())
+            {
+                return Field;
+            }
+            Field.Translator = Iter->second.get();
+            UStruct* FieldStruct = nullptr;
+            if (auto ObjectPropertyBase = CastFieldMacro<ObjectPropertyBaseMacro>(Field.Translator->Property))
+            {
+                FieldStruct = ObjectPropertyBase->PropertyClass;
+            }
+            else if (auto StructProperty = CastFieldMacro<StructPropertyMacro>(Field.Translator->Property))
+            {
+                FieldStruct = StructProperty->Struct;
+            }
+            if (FieldStruct)
+            {
+                Field.FieldMerger = Parent->GetObjectMerger(FieldStruct).get();
+            }
+            return Field;
+        }
+
+        FResolvedField FindField(v8::Isolate* Isolate, v8::Local<v8::String> Key)
+        {
+            const int Hash = Key->GetIdentityHash();
+            auto Range = KeyFields.equal_range(Hash);
+            for (auto It = Range.first; It != Range.second; ++It)
+            {
+                if (It->second.Key == Key)
+                {
+                    return It->second.Field;
+                }
+            }
+
+            const FResolvedField Field = ResolveField(Isolate, Key);
+            if (KeyFields.size() < MaxCachedKeys)
+            {
+                KeyFields.emplace(Hash, FKeyField{v8::Global<v8::String>(Isolate, Key), Field});
+            }
+            return Field;
+        }
+
         void Merge(v8::Isolate* Isolate, v8::Local<v8::Context> Context, v8::Local<v8::Object> JsObject, void* Ptr)
         {
             if (auto Class = Cast<UClass>(Struct))
@@ -407,43 +509,39 @@ private:
                     return;
                 }
             }
-            auto Keys = JsObject->GetOwnPropertyNames(Context).ToLocalChecked();
-            for (decltype(Keys->Length()) i = 0; i < Keys->Length(); ++i)
+            auto KeyArray = JsObject->GetOwnPropertyNames(Context).ToLocalChecked();
+            for (decltype(KeyArray->Length()) i = 0; i < KeyArray->Length(); ++i)
             {
-                auto Key = Keys->Get(Context, i).ToLocalChecked();
-                auto Iter = Fields.find(*v8::String::Utf8Value(Isolate, Key));
-                if (Iter != Fields.end())
+                auto Key = KeyArray->Get(Context, i).ToLocalChecked();
+                // index keys are never property names
+                if (!Key->IsString())
+                {
+                    continue;
+                }
+                const FResolvedField Field = FindField(Isolate, Key.As<v8::String>());
+                if (!Field.Translator)
+                {
+                    continue;
+                }
+                auto MaybeValue = JsObject->Get(Context, Key);
+                if (!MaybeValue.IsEmpty())
                 {
-                    auto MaybeValue = JsObject->Get(Context, Key);
-                    if (!MaybeValue.IsEmpty())
+                    auto Value = MaybeValue.ToLocalChecked();
+                    if (Value->IsObject())
                     {
-                        auto Value = MaybeValue.ToLocalChecked();
-                        if (Value->IsObject())
+                        auto JsObjectField = Value->ToObject(Context).ToLocalChecked();
+                        if (!FV8Utils::GetPointerFast<void>(JsObjectField))
                         {
-                            auto JsObjectField = Value->ToObject(Context).ToLocalChecked();
-                            if (!FV8Utils::GetPointerFast<void>(JsObjectField))
+                            if (Field.FieldMerger)
                             {
-                                UStruct* FieldStruct = nullptr;
-                                if (auto ObjectPropertyBase = CastFieldMacro<ObjectPropertyBaseMacro>(Iter->second->Property))
-                                {
-                                    FieldStruct = ObjectPropertyBase->PropertyClass;
-                                }
-                                else if (auto StructProperty = CastFieldMacro<StructPropertyMacro>(Iter->second->Property))
-                                {
-                                    FieldStruct = StructProperty->Struct;
-                                }
-                                if (FieldStruct)
-                                {
-                                    Parent->GetObjectMerger(FieldStruct)
-                                        ->Merge(Isolate, Context, JsObjectField,
-                                            Iter->second->Property->ContainerPtrToValuePtr<void>(Ptr));
-                                }
-                                continue;
+                                Field.FieldMerger->Merge(Isolate, Context, JsObjectField,
+                                    Field.Translator->Property->ContainerPtrToValuePtr<void>(Ptr));
                             }
+                            continue;
                         }
-                        if (!Value->IsUndefined())
-                            Iter->second->JsToUEInContainer(Isolate, Context, Value, Ptr, true);
                     }
+                    if (!Value->IsUndefined())
+                        Field.Translator->JsToUEInContainer(Isolate, Context, Value, Ptr, true);
                 }
             }
         }
@@ -517,6 +615,13 @@ private:
 private:
     v8::Isolate::CreateParams CreateParams;
 
+#if !defined(WITH_NODEJS) && !defined(WITH_QUICKJS) && V8_MAJOR_VERSION >= 9
+    // must outlive the isolate, contexts are deserialized from it lazily
+    std::shared_ptr<const TArray<uint8>> SnapshotBlob;
+
+    v8::StartupData SnapshotStartupData{nullptr, 0};
+#endif
+
 #if defined(WITH_NODEJS)
     uv_loop_t NodeUVLoop;
 
@@ -581,7 +686,7 @@ private:
 
     TMap<FString, std::shared_ptr<FStructWrapper>> TypeReflectionMap;
 
-    TMap<UObject*, v8::UniquePersistent<v8::Value>> ObjectMap;
+    FObjectHandleTable ObjectMap;
 
     TMap<void*, FObjectCacheNode> StructCache;
 
@@ -702,6 +807,15 @@ private:
 
     std::map<void*, DelegateObjectInfo> DelegateMap;
 
+    // owner -> delegates of DelegateMap bound on it, may hold delegates removed since
+    TMap<const UObjectBase*, TArray<void*>> DelegatesByOwner;
+
+    // delegates whose owner was deleted, cleared by the next CheckDelegateProxies
+    TArray<void*> PendingClearDelegates;
+
+    // the last delegate checked by SweepDelegateProxies, nullptr to start over
+    void* DelegateSweepCursor = nullptr;
+
     TMap<UFunction*, TsFunctionInfo> TsFunctionMap;
 
     TMap<UFunction*, v8::UniquePersistent<v8::Function>> MixinFunctionMap;
@@ -713,11 +827,21 @@ private:
     struct FTimerInfo
     {
         v8::Global<v8::Function> Callback;
-        FUETickDelegateHandle TickerHandle;
+        bool Continue;
+        uint64 Interval;
     };
     uint32_t TimerID = 0;
     TMap<uint32_t, FTimerInfo> TimerInfos;
 
+    // in milliseconds of the ticker time, a cleared timer is only removed from TimerInfos
+    FTimerWheel TimerWheel;
+
+    double TimerSeconds = 0;
+
+    TArray<FTimerWheel::FDueTimer> DueTimers;
+
+    FUETickDelegateHandle TimerTickerHandle;
+
     FUETickDelegateHandle DelegateProxiesCheckerHandler;
 
     V8Inspector* Inspector;
@@ -766,11 +890,29 @@ private:
                 .Check();
         }
     };
-#if defined(WITH_V8_BYTECODE)
+#if !defined(WITH_QUICKJS)
     uint32_t Expect_FlagHash = 0;
 #if V8_MAJOR_VERSION >= 11
     uint32_t Expect_ReadOnlySnapshotChecksum = 0;
 #endif
+
+    FCodeCacheStore CodeCacheStore;
+
+    // scripts compiled without a usable cache, their cache is created once they have run so it also holds
+    // the functions compiled lazily while running
+    struct FPendingCodeCache
+    {
+        FString Path;
+        uint64 SourceHash;
+        v8::Global<v8::UnboundScript> Script;
+        v8::Global<v8::UnboundModuleScript> ModuleScript;
+    };
+
+    std::vector<FPendingCodeCache> PendingCodeCaches;
+
+    void SavePendingCodeCaches();
+
+    FV8StringCache StringCache;
 #endif
 };
 
@@ -0,0 +1,301 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "JsEnvSnapshot.h"
+#include "V8Utils.h"
+#include "Internationalization/Regex.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace PUERTS_NAMESPACE
+{
+#if !defined(WITH_NODEJS) && !defined(WITH_QUICKJS)
+namespace
+{
+// a tiny CommonJS loader living only while the snapshot is built, called with the NODE_ENV and the external modules.
+// an external module is required through the require() of the env booted from the snapshot, when first asked for
+const char* SnapshotPrelude = R"((function (global, nodeEnv, externals) {
+    const factories = Object.create(null);
+    const dependencies = Object.create(null);
+    const cache = Object.create(null);
+    const process = { env: { NODE_ENV: nodeEnv } };
+
+    function load(path) {
+        if (path in cache) return cache[path].exports;
+        const factory = factories[path];
+        if (!factory) throw new Error(`module ${path} is not in the snapshot`);
+        const deps = dependencies[path];
+        const module = cache[path] = { exports: {} };
+        const dir = path.substring(0, path.lastIndexOf('/'));
+        factory.call(module.exports, module.exports, function require(name) {
+            if (externals.indexOf(name) >= 0) {
+                if (typeof global.require !== 'function') throw new Error(`${name} is not in the snapshot, it can not be required while the snapshot is built`);
+                return global.require(name);
+            }
+            if (!(name in deps)) throw new Error(`can not find ${name} in snapshot module ${path}`);
+            return load(deps[name]);
+        }, module, path, dir, process);
+        return module.exports;
+    }
+
+    global.__puertsSnapshotDefine = function (path, deps, factory) {
+        factories[path] = factory;
+        dependencies[path] = deps;
+    };
+
+    global.__puertsSnapshotFinish = function (entries) {
+        const modules = Object.create(null);
+        for (const name in entries) {
+            modules[name] = load(entries[name]);
+        }
+        // let the sources of modules never evaluated (e.g. the production builds) be collected before serializing
+        for (const path in factories) {
+            delete factories[path];
+        }
+        delete global.__puertsSnapshotDefine;
+        delete global.__puertsSnapshotFinish;
+        global.__puertsSnapshotModules = modules;
+    };
+}))";
+
+FString ToJsStringLiteral(const FString& Value)
+{
+    return TEXT("\"") + Value.Replace(TEXT("\\"), TEXT("\\\\")).Replace(TEXT("\""), TEXT("\\\"")) + TEXT("\"");
+}
+
+class FSnapshotBuilder
+{
+public:
+    FSnapshotBuilder(v8::Isolate* InIsolate, v8::Local<v8::Context> InContext, IJSModuleLoader& InModuleLoader,
+        const TArray<FString>& InExternalModuleNames)
+        : Isolate(InIsolate), Context(InContext), ModuleLoader(InModuleLoader), ExternalModuleNames(InExternalModuleNames)
+    {
+    }
+
+    bool Build(const TArray<FString>& ModuleNames, const FString& NodeEnv, FString& OutError)
+    {
+        FString Externals;
+        for (const FString& ExternalModuleName : ExternalModuleNames)
+        {
+            Externals += ToJsStringLiteral(ExternalModuleName) + TEXT(", ");
+        }
+        if (!Run(TEXT("puerts/snapshot_prelude.js"),
+                FString::Printf(TEXT("%s(globalThis, %s, [ %s ]);"), UTF8_TO_TCHAR(SnapshotPrelude), *ToJsStringLiteral(NodeEnv),
+                    *Externals),
+                OutError))
+        {
+            return false;
+        }
+
+        FString Entries;
+        for (const FString& ModuleName : ModuleNames)
+        {
+            FString Path;
+            if (!AddModule(TEXT(""), ModuleName, Path, OutError))
+            {
+                return false;
+            }
+            Entries += FString::Printf(TEXT("%s: %s, "), *ToJsStringLiteral(ModuleName), *ToJsStringLiteral(Path));
+        }
+
+        return Run(TEXT("puerts/snapshot_finish.js"), FString::Printf(TEXT("__puertsSnapshotFinish({ %s });"), *Entries), OutError);
+    }
+
+private:
+    bool AddModule(const FString& RequiredDir, const FString& ModuleName, FString& OutPath, FString& OutError)
+    {
+        FString Path;
+        FString AbsolutePath;
+        if (!ModuleLoader.Search(RequiredDir, ModuleName, Path, AbsolutePath))
+        {
+            OutError = FString::Printf(TEXT("can not find %s in %s"), *ModuleName, *RequiredDir);
+            return false;
+        }
+
+        if (Path.EndsWith(TEXT("package.json")))
+        {
+            FString Main;
+            return ReadPackageMain(Path, Main, OutError) && AddModule(FPaths::GetPath(Path), Main, OutPath, OutError);
+        }
+
+        OutPath = Path;
+        if (Defined.Contains(Path))
+        {
+            return true;
+        }
+
+        if (!Path.EndsWith(TEXT(".js")) && !Path.EndsWith(TEXT(".cjs")))
+        {
+            OutError = FString::Printf(TEXT("%s is not a CommonJS module, it can not be put into the snapshot"), *Path);
+            return false;
+        }
+        Defined.Add(Path);
+
+        TArray<uint8> Content;
+        if (!ModuleLoader.Load(Path, Content))
+        {
+            OutError = FString::Printf(TEXT("can not load %s"), *Path);
+            return false;
+        }
+
+        FString Source;
+        FFileHelper::BufferToString(Source, Content.GetData(), Content.Num());
+
+        // only literal require() calls can be resolved ahead of time, the ones we can not resolve may sit in comments or
+        // dead branches, a real miss throws from the prelude's require while evaluating
+        FString Dependencies;
+        TSet<FString> Visited;
+        const FRegexPattern RequirePattern(TEXT("require\\s*\\(\\s*['\"]([^'\"]+)['\"]\\s*\\)"));
+        FRegexMatcher Matcher(RequirePattern, Source);
+        while (Matcher.FindNext())
+        {
+            const FString Dependency = Matcher.GetCaptureGroup(1);
+            bool bAlreadyVisited = false;
+            Visited.Add(Dependency, &bAlreadyVisited);
+            if (bAlreadyVisited || ExternalModuleNames.Contains(Dependency))
+            {
+                continue;
+            }
+
+            FString DependencyPath;
+            FString DependencyAbsolutePath;
+            if (!ModuleLoader.Search(FPaths::GetPath(Path), Dependency, DependencyPath, DependencyAbsolutePath))
+            {
+                continue;
+            }
+
+            if (!AddModule(FPaths::GetPath(Path), Dependency, DependencyPath, OutError))
+            {
+                return false;
+            }
+            Dependencies += FString::Printf(TEXT("%s: %s, "), *ToJsStringLiteral(Dependency), *ToJsStringLiteral(DependencyPath));
+        }
+
+        // same wrapper shape as modular.js so line numbers in stack traces match the file
+        const FString Script = FString::Printf(
+            TEXT("__puertsSnapshotDefine(%s, { %s }, function (exports, require, module, __filename, __dirname, process) { %s\n});"),
+            *ToJsStringLiteral(Path), *Dependencies, *Source);
+        return Run(Path, Script, OutError);
+    }
+
+    bool ReadPackageMain(const FString& Path, FString& OutMain, FString& OutError)
+    {
+        TArray<uint8> Content;
+        if (!ModuleLoader.Load(Path, Content))
+        {
+            OutError = FString::Printf(TEXT("can not load %s"), *Path);
+            return false;
+        }
+
+        v8::TryCatch TryCatch(Isolate);
+        v8::Local<v8::Value> Package;
+        if (!v8::JSON::Parse(Context, FV8Utils::ToV8StringFromFileContent(Isolate, Content)).ToLocal(&Package) || !Package->IsObject())
+        {
+            OutError = FString::Printf(TEXT("invalid package file %s"), *Path);
+            return false;
+        }
+
+        v8::Local<v8::Object> PackageObject = Package.As<v8::Object>();
+        v8::Local<v8::Value> Type = PackageObject->Get(Context, FV8Utils::ToV8String(Isolate, "type")).ToLocalChecked();
+        if (Type->IsString() && FV8Utils::ToFString(Isolate, Type) == TEXT("module"))
+        {
+            OutError = FString::Printf(TEXT("%s is an ES module package, it can not be put into the snapshot"), *Path);
+            return false;
+        }
+
+        v8::Local<v8::Value> Main = PackageObject->Get(Context, FV8Utils::ToV8String(Isolate, "main")).ToLocalChecked();
+        OutMain = Main->IsString() ? FV8Utils::ToFString(Isolate, Main) : FString(TEXT("index.js"));
+        return true;
+    }
+
+    bool Run(const FString& Name, const FString& Source, FString& OutError)
+    {
+        v8::HandleScope HandleScope(Isolate);
+#if V8_MAJOR_VERSION > 8
+        v8::ScriptOrigin Origin(Isolate, FV8Utils::ToV8String(Isolate, Name));
+#else
+        v8::ScriptOrigin Origin(FV8Utils::ToV8String(Isolate, Name));
+#endif
+        v8::TryCatch TryCatch(Isolate);
+
+        v8::Local<v8::Script> CompiledScript;
+        if (!v8::Script::Compile(Context, FV8Utils::ToV8String(Isolate, Source), &Origin).ToLocal(&CompiledScript) ||
+            CompiledScript->Run(Context).IsEmpty())
+        {
+            OutError = FV8Utils::TryCatchToString(Isolate, &TryCatch);
+            return false;
+        }
+        return true;
+    }
+
+    v8::Isolate* Isolate;
+
+    v8::Local<v8::Context> Context;
+
+    IJSModuleLoader& ModuleLoader;
+
+    const TArray<FString>& ExternalModuleNames;
+
+    TSet<FString> Defined;
+};
+}    // namespace
+#endif
+
+bool FJsEnvSnapshot::Create(std::shared_ptr<IJSModuleLoader> ModuleLoader, const TArray<FString>& ModuleNames,
+    const TArray<FString>& ExternalModuleNames, const FString& NodeEnv, TArray<uint8>& OutBlob, FString& OutError)
+{
+#if !defined(WITH_NODEJS) && !defined(WITH_QUICKJS)
+    check(ModuleLoader);
+    bool Succeeded = false;
+
+    // SnapshotCreator owns and enters its own isolate, must not be called from inside a running FJsEnv
+    v8::SnapshotCreator Creator;
+    v8::Isolate* Isolate = Creator.GetIsolate();
+    {
+        v8::HandleScope HandleScope(Isolate);
+        v8::Local<v8::Context> Context = v8::Context::New(Isolate);
+        {
+            v8::Context::Scope ContextScope(Context);
+            Succeeded = FSnapshotBuilder(Isolate, Context, *ModuleLoader, ExternalModuleNames).Build(ModuleNames, NodeEnv, OutError);
+        }
+        // CreateBlob must run even on failure, otherwise the creator's isolate is left in a bad state
+        Creator.SetDefaultContext(Succeeded ? Context : v8::Context::New(Isolate));
+    }
+
+    // keep the compiled functions, skipping their compilation is what the snapshot is for
+    v8::StartupData Blob = Creator.CreateBlob(v8::SnapshotCreator::FunctionCodeHandling::kKeep);
+    if (Succeeded && Blob.data && Blob.raw_size > 0)
+    {
+        OutBlob.Reset(Blob.raw_size);
+        OutBlob.Append(reinterpret_cast<const uint8*>(Blob.data), Blob.raw_size);
+    }
+    else if (Succeeded)
+    {
+        OutError = TEXT("V8 failed to serialize the snapshot");
+        Succeeded = false;
+    }
+#if !WITH_EDITOR
+    delete[] Blob.data;    //编辑器下是v8.dll分配的，ue里的delete被重载了，这delete会有问题
+#endif
+
+    return Succeeded;
+#else
+    OutError = TEXT("startup snapshot is only supported by the V8 backend");
+    return false;
+#endif
+}
+
+FString FJsEnvSnapshot::GetNodeEnv()
+{
+#if UE_BUILD_SHIPPING
+    return TEXT("production");
+#else
+    return TEXT("development");
+#endif
+}
+}    // namespace PUERTS_NAMESPACE
@@ -0,0 +1,102 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UObjectArray.h"
+#include "NamespaceDef.h"
+
+PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#pragma warning(push, 0)
+#include "v8.h"
+#pragma warning(pop)
+PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
+
+namespace PUERTS_NAMESPACE
+{
+/**
+ * The JS objects of the bound UObjects, indexed like GUObjectArray so a lookup is an array access instead of a hash probe.
+ * A slot remembers its object and the serial number of the GUObjectArray item, an object reusing the index of a
+ * deleted one is never mistaken for it. Chunks are allocated when the first object of their index range is bound and
+ * freed once none is left.
+ */
+class FObjectHandleTable
+{
+public:
+    v8::UniquePersistent<v8::Value>* Find(const UObjectBase* Object)
+    {
+        FSlot* Slot = FindSlot(Object);
+        if (!Slot ||
+            Slot->SerialNumber != GUObjectArray.IndexToObjectUnsafeForGC(GUObjectArray.ObjectToIndex(Object))->GetSerialNumber())
+        {
+            return nullptr;
+        }
+        return &Slot->Value;
+    }
+
+    /**
+     * Skips the serial number check, for the delete notification: the serial number may be cleared already by then
+     */
+    v8::UniquePersistent<v8::Value>* FindDeleting(const UObjectBase* Object)
+    {
+        FSlot* Slot = FindSlot(Object);
+        return Slot ? &Slot->Value : nullptr;
+    }
+
+    /**
+     * Replaces the JS object bound to Object, if any
+     */
+    v8::UniquePersistent<v8::Value>& Emplace(const UObjectBase* Object, v8::UniquePersistent<v8::Value>&& Value);
+
+    bool Remove(const UObjectBase* Object);
+
+    void Empty();
+
+    int32 Num() const
+    {
+        return NumObjects;
+    }
+
+private:
+    static constexpr int32 NumSlotsPerChunk = 16 * 1024;
+
+    struct FSlot
+    {
+        const UObjectBase* Object = nullptr;
+        int32 SerialNumber = 0;
+        v8::UniquePersistent<v8::Value> Value;
+    };
+
+    struct FChunk
+    {
+        TUniquePtr<FSlot[]> Slots;
+        int32 NumObjects = 0;
+    };
+
+    /**
+     * @return the slot bound to Object, by index and pointer only
+     */
+    FSlot* FindSlot(const UObjectBase* Object)
+    {
+        const int32 Index = GUObjectArray.ObjectToIndex(Object);
+        const int32 ChunkIndex = Index / NumSlotsPerChunk;
+        if (Index < 0 || ChunkIndex >= Chunks.Num() || !Chunks[ChunkIndex].Slots)
+        {
+            return nullptr;
+        }
+
+        FSlot& Slot = Chunks[ChunkIndex].Slots[Index % NumSlotsPerChunk];
+        return Slot.Object == Object ? &Slot : nullptr;
+    }
+
+    TArray<FChunk> Chunks;
+
+    int32 NumObjects = 0;
+};
+}    // namespace PUERTS_NAMESPACE
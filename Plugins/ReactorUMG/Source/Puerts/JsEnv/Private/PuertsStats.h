@@ -0,0 +1,16 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include "Stats/Stats.h"
+
+/*
+ * Stats group of the JsEnv module, like the live delegate proxies and the string caches
+ */
+DECLARE_STATS_GROUP(TEXT("Puerts"), STATGROUP_Puerts, STATCAT_Advanced);
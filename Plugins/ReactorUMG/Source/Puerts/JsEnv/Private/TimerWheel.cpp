@@ -0,0 +1,95 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "TimerWheel.h"
+#include "Algo/Sort.h"
+
+namespace PUERTS_NAMESPACE
+{
+FTimerWheel::FTimerWheel() : Time(0), NumTimers(0)
+{
+}
+
+void FTimerWheel::Add(uint32 Id, uint64 ExpireTime)
+{
+    Insert({Id, FMath::Max(ExpireTime, Time + 1)});
+    ++NumTimers;
+}
+
+void FTimerWheel::Insert(const FDueTimer& Timer)
+{
+    // a timer cascaded in the slot of the current time is collected right after
+    const uint64 Delay = Timer.ExpireTime > Time ? Timer.ExpireTime - Time : 0;
+    // beyond the last level, the timer goes back down to it when its slot comes up
+    const uint64 SlotTime = Delay > MaxDelay ? Time + MaxDelay : FMath::Max(Timer.ExpireTime, Time);
+
+    int32 Level = 0;
+    while (Level < NumLevels - 1 && Delay >= (uint64(1) << (LevelBits * (Level + 1))))
+    {
+        ++Level;
+    }
+    Slots[Level][(SlotTime >> (LevelBits * Level)) & SlotMask].Add(Timer);
+}
+
+void FTimerWheel::Cascade(int32 Level)
+{
+    TArray<FDueTimer> Timers = MoveTemp(Slots[Level][(Time >> (LevelBits * Level)) & SlotMask]);
+    for (const FDueTimer& Timer : Timers)
+    {
+        Insert(Timer);
+    }
+}
+
+void FTimerWheel::Advance(uint64 NewTime, TArray<FDueTimer>& OutDue)
+{
+    const int32 FirstDue = OutDue.Num();
+    while (Time < NewTime)
+    {
+        if (NumTimers == 0)
+        {
+            Time = NewTime;
+            break;
+        }
+
+        ++Time;
+        // the higher levels move down once the lower ones went round
+        for (int32 Level = 1; Level < NumLevels && (Time & ((uint64(1) << (LevelBits * Level)) - 1)) == 0; ++Level)
+        {
+            Cascade(Level);
+        }
+
+        TArray<FDueTimer>& Slot = Slots[0][Time & SlotMask];
+        if (Slot.Num() > 0)
+        {
+            OutDue.Append(Slot);
+            NumTimers -= Slot.Num();
+            Slot.Reset();
+        }
+    }
+
+    if (OutDue.Num() - FirstDue > 1)
+    {
+        Algo::Sort(MakeArrayView(OutDue.GetData() + FirstDue, OutDue.Num() - FirstDue),
+            [](const FDueTimer& A, const FDueTimer& B)
+            { return A.ExpireTime < B.ExpireTime || (A.ExpireTime == B.ExpireTime && A.Id < B.Id); });
+    }
+}
+
+void FTimerWheel::Reset()
+{
+    for (auto& Level : Slots)
+    {
+        for (TArray<FDueTimer>& Slot : Level)
+        {
+            Slot.Empty();
+        }
+    }
+    Time = 0;
+    NumTimers = 0;
+}
+}    // namespace PUERTS_NAMESPACE
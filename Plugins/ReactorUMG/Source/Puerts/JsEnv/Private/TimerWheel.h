@@ -0,0 +1,68 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NamespaceDef.h"
+
+namespace PUERTS_NAMESPACE
+{
+/**
+ * Hierarchical timer wheel with a millisecond resolution, 4 levels of 256 slots: adding a timer is O(1) and advancing
+ * only touches the slots passed, a timer far in the future is moved down a level each time its slot comes up.
+ * The wheel only knows timer ids, a cancelled timer is left in its slot and skipped by the owner when it comes due.
+ */
+class FTimerWheel
+{
+public:
+    struct FDueTimer
+    {
+        uint32 Id;
+        uint64 ExpireTime;
+    };
+
+    FTimerWheel();
+
+    uint64 GetTime() const
+    {
+        return Time;
+    }
+
+    /**
+     * @param ExpireTime in milliseconds, a time not after the current one fires on the next advance
+     */
+    void Add(uint32 Id, uint64 ExpireTime);
+
+    /**
+     * Moves the wheel to NewTime and collects the timers expired on the way
+     * @param OutDue sorted by expire time then id
+     */
+    void Advance(uint64 NewTime, TArray<FDueTimer>& OutDue);
+
+    void Reset();
+
+private:
+    static constexpr int32 LevelBits = 8;
+    static constexpr int32 SlotsPerLevel = 1 << LevelBits;
+    static constexpr int32 NumLevels = 4;
+    static constexpr uint64 SlotMask = SlotsPerLevel - 1;
+    static constexpr uint64 MaxDelay = (uint64(1) << (LevelBits * NumLevels)) - 1;
+
+    void Insert(const FDueTimer& Timer);
+
+    void Cascade(int32 Level);
+
+    TArray<FDueTimer> Slots[NumLevels][SlotsPerLevel];
+
+    uint64 Time;
+
+    // includes cancelled timers still in a slot
+    int32 NumTimers;
+};
+}    // namespace PUERTS_NAMESPACE
@@ -0,0 +1,164 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "V8StringCache.h"
+#include "V8Utils.h"
+#include "PuertsStats.h"
+
+#if !defined(WITH_QUICKJS)
+DECLARE_DWORD_COUNTER_STAT(TEXT("FName String Hits"), STAT_PuertsNameStringHits, STATGROUP_Puerts);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FName String Misses"), STAT_PuertsNameStringMisses, STATGROUP_Puerts);
+DECLARE_DWORD_COUNTER_STAT(TEXT("JS Name Hits"), STAT_PuertsJsNameHits, STATGROUP_Puerts);
+DECLARE_DWORD_COUNTER_STAT(TEXT("JS Name Misses"), STAT_PuertsJsNameMisses, STATGROUP_Puerts);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FString LRU Hits"), STAT_PuertsStringLruHits, STATGROUP_Puerts);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FString LRU Misses"), STAT_PuertsStringLruMisses, STATGROUP_Puerts);
+
+namespace PUERTS_NAMESPACE
+{
+void FV8StringCache::Attach(v8::Isolate* Isolate)
+{
+    StringEntries.Reserve(MaxStrings);
+    Isolate->SetData(STRING_CACHE_POS_IN_ISOLATE, this);
+}
+
+void FV8StringCache::Detach(v8::Isolate* Isolate)
+{
+    Isolate->SetData(STRING_CACHE_POS_IN_ISOLATE, nullptr);
+    NameStrings.Empty();
+    JsNames.Empty();
+    NumJsNames = 0;
+    StringEntries.Empty();
+    StringIndices.Empty();
+    MostRecentString = INDEX_NONE;
+    LeastRecentString = INDEX_NONE;
+}
+
+v8::Local<v8::String> FV8StringCache::ToV8String(v8::Isolate* Isolate, const FName& Name)
+{
+    if (v8::Global<v8::String>* Cached = NameStrings.Find(Name))
+    {
+        INC_DWORD_STAT(STAT_PuertsNameStringHits);
+        return Cached->Get(Isolate);
+    }
+
+    INC_DWORD_STAT(STAT_PuertsNameStringMisses);
+    const FString Out = FV8Utils::ToComparisonString(Name);
+    v8::Local<v8::String> Result =
+        v8::String::NewFromTwoByte(Isolate, TCHAR_TO_UTF16(*Out), v8::NewStringType::kInternalized).ToLocalChecked();
+    if (NameStrings.Num() < MaxNames)
+    {
+        NameStrings.Emplace(Name, v8::Global<v8::String>(Isolate, Result));
+    }
+    return Result;
+}
+
+FName FV8StringCache::ToFName(v8::Isolate* Isolate, v8::Local<v8::String> String)
+{
+    const int Hash = String->GetIdentityHash();
+    auto Candidates = JsNames.Find(Hash);
+    if (Candidates)
+    {
+        for (const FJsName& Candidate : *Candidates)
+        {
+            // internalized strings, mostly property keys, compare by identity first
+            if (Candidate.String.Get(Isolate)->StringEquals(String))
+            {
+                INC_DWORD_STAT(STAT_PuertsJsNameHits);
+                return Candidate.Name;
+            }
+        }
+    }
+
+    INC_DWORD_STAT(STAT_PuertsJsNameMisses);
+    FName Name = UTF8_TO_TCHAR(*(v8::String::Utf8Value(Isolate, String)));
+    // long strings passed as names are rarely property keys, and are not worth keeping alive
+    if (NumJsNames < MaxNames && String->Length() <= MaxStringLength)
+    {
+        JsNames.FindOrAdd(Hash).Add({v8::Global<v8::String>(Isolate, String), Name});
+        ++NumJsNames;
+    }
+    return Name;
+}
+
+v8::Local<v8::String> FV8StringCache::ToV8String(v8::Isolate* Isolate, const FString& String)
+{
+    if (int32* Index = StringIndices.Find(String))
+    {
+        INC_DWORD_STAT(STAT_PuertsStringLruHits);
+        if (*Index != MostRecentString)
+        {
+            Unlink(*Index);
+            LinkFirst(*Index);
+        }
+        return StringEntries[*Index].Value.Get(Isolate);
+    }
+
+    INC_DWORD_STAT(STAT_PuertsStringLruMisses);
+    v8::Local<v8::String> Result =
+        v8::String::NewFromTwoByte(Isolate, TCHAR_TO_UTF16(*String), v8::NewStringType::kNormal).ToLocalChecked();
+
+    int32 Index;
+    if (StringEntries.Num() < MaxStrings)
+    {
+        Index = StringEntries.AddDefaulted();
+    }
+    else
+    {
+        Index = LeastRecentString;
+        Unlink(Index);
+        StringIndices.Remove(StringEntries[Index].Key);
+    }
+
+    FStringEntry& Entry = StringEntries[Index];
+    Entry.Key = String;
+    Entry.Value.Reset(Isolate, Result);
+    LinkFirst(Index);
+    StringIndices.Add(String, Index);
+    return Result;
+}
+
+void FV8StringCache::Unlink(int32 Index)
+{
+    FStringEntry& Entry = StringEntries[Index];
+    if (Entry.Prev != INDEX_NONE)
+    {
+        StringEntries[Entry.Prev].Next = Entry.Next;
+    }
+    else
+    {
+        MostRecentString = Entry.Next;
+    }
+    if (Entry.Next != INDEX_NONE)
+    {
+        StringEntries[Entry.Next].Prev = Entry.Prev;
+    }
+    else
+    {
+        LeastRecentString = Entry.Prev;
+    }
+    Entry.Prev = INDEX_NONE;
+    Entry.Next = INDEX_NONE;
+}
+
+void FV8StringCache::LinkFirst(int32 Index)
+{
+    FStringEntry& Entry = StringEntries[Index];
+    Entry.Prev = INDEX_NONE;
+    Entry.Next = MostRecentString;
+    if (MostRecentString != INDEX_NONE)
+    {
+        StringEntries[MostRecentString].Prev = Index;
+    }
+    MostRecentString = Index;
+    if (LeastRecentString == INDEX_NONE)
+    {
+        LeastRecentString = Index;
+    }
+}
+}    // namespace PUERTS_NAMESPACE
+#endif
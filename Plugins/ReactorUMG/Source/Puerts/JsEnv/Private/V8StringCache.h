@@ -0,0 +1,109 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NamespaceDef.h"
+#include "DataTransfer.h"
+
+PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#pragma warning(push, 0)
+#include "v8.h"
+#pragma warning(pop)
+PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
+
+#if !defined(WITH_QUICKJS)
+namespace PUERTS_NAMESPACE
+{
+/**
+ * Per isolate cache of the strings crossing between UE and JS, found through the isolate data so FV8Utils can use it.
+ * FNames map to internalized v8 strings, and JS strings back to the FName created from them, both kept until the isolate
+ * goes away. Short FStrings, like class names and text content, are kept in a small LRU.
+ * Hits and misses are reported in the Puerts stat group.
+ */
+class FV8StringCache
+{
+public:
+    static constexpr int32 MaxStringLength = 64;
+
+    FORCEINLINE static FV8StringCache* Get(v8::Isolate* Isolate)
+    {
+        return static_cast<FV8StringCache*>(Isolate->GetData(STRING_CACHE_POS_IN_ISOLATE));
+    }
+
+    void Attach(v8::Isolate* Isolate);
+
+    /**
+     * Releases the cached strings, must be called before the isolate is disposed
+     */
+    void Detach(v8::Isolate* Isolate);
+
+    v8::Local<v8::String> ToV8String(v8::Isolate* Isolate, const FName& Name);
+
+    FName ToFName(v8::Isolate* Isolate, v8::Local<v8::String> String);
+
+    /**
+     * @param String at most MaxStringLength characters
+     */
+    v8::Local<v8::String> ToV8String(v8::Isolate* Isolate, const FString& String);
+
+private:
+    static constexpr int32 MaxNames = 16 * 1024;
+
+    static constexpr int32 MaxStrings = 512;
+
+    // FString compares and hashes case insensitive by default
+    struct FCaseSensitiveKeyFuncs : TDefaultMapHashableKeyFuncs<FString, int32, false>
+    {
+        static FORCEINLINE bool Matches(const FString& A, const FString& B)
+        {
+            return A.Equals(B, ESearchCase::CaseSensitive);
+        }
+
+        static FORCEINLINE uint32 GetKeyHash(const FString& Key)
+        {
+            return FCrc::StrCrc32(*Key);
+        }
+    };
+
+    struct FJsName
+    {
+        v8::Global<v8::String> String;
+        FName Name;
+    };
+
+    struct FStringEntry
+    {
+        FString Key;
+        v8::Global<v8::String> Value;
+        int32 Prev = INDEX_NONE;
+        int32 Next = INDEX_NONE;
+    };
+
+    void Unlink(int32 Index);
+
+    void LinkFirst(int32 Index);
+
+    TMap<FName, v8::Global<v8::String>> NameStrings;
+
+    // by the hash V8 keeps in the string, a few names may share one
+    TMap<int, TArray<FJsName, TInlineAllocator<1>>> JsNames;
+
+    int32 NumJsNames = 0;
+
+    TArray<FStringEntry> StringEntries;
+
+    TMap<FString, int32, FDefaultSetAllocator, FCaseSensitiveKeyFuncs> StringIndices;
+
+    int32 MostRecentString = INDEX_NONE;
+
+    int32 LeastRecentString = INDEX_NONE;
+};
+}    // namespace PUERTS_NAMESPACE
+#endif
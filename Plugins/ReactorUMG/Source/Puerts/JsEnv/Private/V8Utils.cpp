@@ -1,4 +1,46 @@
 #include <V8Utils.h>
+#include "V8StringCache.h"
+
+v8::Local<v8::String> puerts::FV8Utils::ToV8String(v8::Isolate* Isolate, const FString& String)
+{
+#ifndef WITH_QUICKJS
+    // long strings are rarely repeated, hashing them would cost more than it saves
+    if (String.Len() <= FV8StringCache::MaxStringLength)
+    {
+        if (FV8StringCache* Cache = FV8StringCache::Get(Isolate))
+        {
+            return Cache->ToV8String(Isolate, String);
+        }
+    }
+#endif
+    // return ToV8String(Isolate, TCHAR_TO_UTF8(*String));
+    return ToV8String(Isolate, *String);
+}
+
+v8::Local<v8::String> puerts::FV8Utils::ToV8String(v8::Isolate* Isolate, const FName& String)
+{
+#ifndef WITH_QUICKJS
+    if (FV8StringCache* Cache = FV8StringCache::Get(Isolate))
+    {
+        return Cache->ToV8String(Isolate, String);
+    }
+#endif
+    return ToV8String(Isolate, ToComparisonString(String));
+}
+
+FName puerts::FV8Utils::ToFName(v8::Isolate* Isolate, v8::Local<v8::Value> Value)
+{
+#ifndef WITH_QUICKJS
+    if (!Value.IsEmpty() && Value->IsString())
+    {
+        if (FV8StringCache* Cache = FV8StringCache::Get(Isolate))
+        {
+            return Cache->ToFName(Isolate, Value.As<v8::String>());
+        }
+    }
+#endif
+    return UTF8_TO_TCHAR(*(v8::String::Utf8Value(Isolate, Value)));
+}
 
 v8::Local<v8::String> puerts::FV8Utils::ToV8String(v8::Isolate* Isolate, const TCHAR* String)
 {
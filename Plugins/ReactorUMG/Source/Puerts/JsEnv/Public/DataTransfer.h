@@ -32,6 +32,10 @@ PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
 #define PESAPI_PRIVATE_DATA_POS_IN_ISOLATE (MAPPER_ISOLATE_DATA_POS + 1)
 #endif
 
+#ifndef STRING_CACHE_POS_IN_ISOLATE
+#define STRING_CACHE_POS_IN_ISOLATE (MAPPER_ISOLATE_DATA_POS + 2)
+#endif
+
 #define RELEASED_UOBJECT ((UObject*) 12)
 #define RELEASED_UOBJECT_MEMBER ((void*) 12)
 
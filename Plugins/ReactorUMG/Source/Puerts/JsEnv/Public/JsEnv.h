@@ -69,7 +69,8 @@ public:
 
     FJsEnv(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::shared_ptr<ILogger> InLogger, int InDebugPort,
         std::function<void(const FString&)> InOnSourceLoadedCallback = nullptr, const FString InFlags = FString(),
-        void* InExternalRuntime = nullptr, void* InExternalContext = nullptr);
+        void* InExternalRuntime = nullptr, void* InExternalContext = nullptr,
+        std::shared_ptr<const TArray<uint8>> InSnapshotBlob = nullptr);
 
     void Start(const FString& ModuleName, const TArray<TPair<FString, UObject*>>& Arguments = TArray<TPair<FString, UObject*>>());
 
@@ -104,6 +105,10 @@ public:
 
     void ForceReloadJsFile(const FString& ModuleName);
 
+    // Lets JS call a native UFunction whose parameters are numbers, bools, enums and UObject pointers through V8's fast
+    // API. The function must not call into JS, and has to be added before its class is first used from JS
+    static void AddFastCallFunction(UFunction* Function);
+
 private:
     std::unique_ptr<IJsEnv> GameScript;
 };
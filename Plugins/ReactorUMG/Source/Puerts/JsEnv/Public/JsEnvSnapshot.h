@@ -0,0 +1,45 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "CoreMinimal.h"
+#include "JSModuleLoader.h"
+
+namespace PUERTS_NAMESPACE
+{
+/**
+ * Builds a custom V8 startup snapshot whose default context already evaluated a set of CommonJS modules.
+ * Only self-contained JavaScript (react, react-reconciler...) can live in a snapshot: modules touching
+ * `ue`/`puerts` need native bindings that are created per FJsEnv and can not be serialized. Neither can modules
+ * capturing host functions like setTimeout while they are evaluated (scheduler), those are left to the env as externals.
+ * The evaluated exports are picked up by modular.js as buildin modules when an FJsEnv boots from the blob.
+ * The blob is only valid for the V8 build and platform that created it.
+ */
+class JSENV_API FJsEnvSnapshot
+{
+public:
+    /**
+     * @param ModuleNames names passed to require(), e.g. "react", "react/jsx-runtime"
+     * @param ExternalModuleNames left out of the snapshot, a snapshot module requiring one gets it from the require() of
+     * the env when first asked for, not while the snapshot is built
+     * @param NodeEnv process.env.NODE_ENV seen by the modules, e.g. "production"
+     * @return false if a module can not be found, is not CommonJS or throws while evaluating
+     */
+    static bool Create(std::shared_ptr<IJSModuleLoader> ModuleLoader, const TArray<FString>& ModuleNames,
+        const TArray<FString>& ExternalModuleNames, const FString& NodeEnv, TArray<uint8>& OutBlob, FString& OutError);
+
+    /**
+     * @return process.env.NODE_ENV of every env of this build, "production" in Shipping, the snapshot booted from must
+     * be built for it
+     */
+    static FString GetNodeEnv();
+};
+}    // namespace PUERTS_NAMESPACE
@@ -100,18 +100,13 @@ public:
 
     static FString ToFString(v8::Isolate* Isolate, v8::Local<v8::Value> Value);
 
-    FORCEINLINE static FName ToFName(v8::Isolate* Isolate, v8::Local<v8::Value> Value)
-    {
-        return UTF8_TO_TCHAR(*(v8::String::Utf8Value(Isolate, Value)));
-    }
+    static FName ToFName(v8::Isolate* Isolate, v8::Local<v8::Value> Value);
 
-    FORCEINLINE static v8::Local<v8::String> ToV8String(v8::Isolate* Isolate, const FString& String)
-    {
-        // return ToV8String(Isolate, TCHAR_TO_UTF8(*String));
-        return ToV8String(Isolate, *String);
-    }
+    static v8::Local<v8::String> ToV8String(v8::Isolate* Isolate, const FString& String);
+
+    static v8::Local<v8::String> ToV8String(v8::Isolate* Isolate, const FName& String);
 
-    FORCEINLINE static v8::Local<v8::String> ToV8String(v8::Isolate* Isolate, const FName& String)
+    FORCEINLINE static FString ToComparisonString(const FName& String)
     {
         const FNameEntry* Entry = String.GetComparisonNameEntry();
         FString Out;
@@ -129,7 +124,7 @@ public:
             Out.AppendInt(NAME_INTERNAL_TO_EXTERNAL(String.GetNumber()));
         }
 
-        return ToV8String(Isolate, Out);
+        return Out;
     }
 
     FORCEINLINE static v8::Local<v8::String> ToV8String(v8::Isolate* Isolate, const FText& String)
@@ -0,0 +1,189 @@
+#include "ImageAtlas.h"
+#include "ImageTextureLoader.h"
+#include "ReactorAtlasImage.h"
+#include "ReactorUMGSetting.h"
+#include "Engine/Texture2D.h"
+#include "RenderUtils.h"
+
+namespace
+{
+// transparent texels around every image would fade its edges under bilinear filtering, its border is repeated instead
+constexpr int32 AtlasPadding = 1;
+constexpr int32 AtlasBytesPerPixel = 4;
+}
+
+FImageAtlas& FImageAtlas::Get()
+{
+	static FImageAtlas Instance;
+	return Instance;
+}
+
+int32 FImageAtlas::GetMaxImageSize() const
+{
+	const UReactorUMGSetting* Setting = GetDefault<UReactorUMGSetting>();
+	if (!Setting->bUseImageAtlas)
+	{
+		return 0;
+	}
+
+	const int32 CurrentPageSize = Pages.Num() > 0 ? PageSize : Setting->ImageAtlasPageSize;
+	return FMath::Clamp(Setting->MaxAtlasImageSize, 0, CurrentPageSize - 2 * AtlasPadding);
+}
+
+UReactorAtlasImage* FImageAtlas::Add(const FDecodedImage& Image)
+{
+	check(IsInGameThread());
+	const int32 MaxImageSize = GetMaxImageSize();
+	if (Image.Mips.Num() == 0 || Image.SizeX > MaxImageSize || Image.SizeY > MaxImageSize)
+	{
+		return nullptr;
+	}
+
+	const int32 SlotWidth = Image.SizeX + 2 * AtlasPadding;
+	const int32 SlotHeight = Image.SizeY + 2 * AtlasPadding;
+
+	int32 PageIndex = INDEX_NONE;
+	FIntPoint Position;
+	for (int32 Index = 0; Index < Pages.Num(); ++Index)
+	{
+		if (Allocate(Pages[Index], SlotWidth, SlotHeight, Position))
+		{
+			PageIndex = Index;
+			break;
+		}
+	}
+
+	if (PageIndex == INDEX_NONE)
+	{
+		FPage& Page = AddPage();
+		if (!Page.Texture)
+		{
+			Pages.Pop();
+			return nullptr;
+		}
+
+		PageIndex = Pages.Num() - 1;
+		Allocate(Page, SlotWidth, SlotHeight, Position);
+	}
+
+	FPage& Page = Pages[PageIndex];
+	Upload(Page.Texture, Image, Position);
+	++Page.NumImages;
+
+	UReactorAtlasImage* AtlasImage = NewObject<UReactorAtlasImage>();
+	AtlasImage->AtlasTexture = Page.Texture;
+	AtlasImage->ImageSize = FIntPoint(Image.SizeX, Image.SizeY);
+	AtlasImage->StartUV = FVector2f(Position.X + AtlasPadding, Position.Y + AtlasPadding) / PageSize;
+	AtlasImage->SizeUV = FVector2f(Image.SizeX, Image.SizeY) / PageSize;
+	AtlasImage->PageIndex = PageIndex;
+	return AtlasImage;
+}
+
+void FImageAtlas::Release(int32 PageIndex)
+{
+	if (!Pages.IsValidIndex(PageIndex))
+	{
+		return;
+	}
+
+	FPage& Page = Pages[PageIndex];
+	if (--Page.NumImages <= 0)
+	{
+		// nothing samples the page anymore, its old pixels are simply overwritten by the next images
+		Page.NumImages = 0;
+		Page.Shelves.Reset();
+		Page.UsedHeight = 0;
+	}
+}
+
+bool FImageAtlas::Allocate(FPage& Page, int32 Width, int32 Height, FIntPoint& OutPosition) const
+{
+	// the lowest shelf the image fits in without wasting more than half of the shelf height
+	FShelf* BestShelf = nullptr;
+	for (FShelf& Shelf : Page.Shelves)
+	{
+		if (Shelf.Height >= Height && Shelf.Height <= Height * 2 && Shelf.UsedWidth + Width <= PageSize &&
+			(!BestShelf || Shelf.Height < BestShelf->Height))
+		{
+			BestShelf = &Shelf;
+		}
+	}
+
+	if (!BestShelf)
+	{
+		if (Page.UsedHeight + Height > PageSize || Width > PageSize)
+		{
+			return false;
+		}
+
+		BestShelf = &Page.Shelves.AddDefaulted_GetRef();
+		BestShelf->Y = Page.UsedHeight;
+		BestShelf->Height = Height;
+		Page.UsedHeight += Height;
+	}
+
+	OutPosition = FIntPoint(BestShelf->UsedWidth, BestShelf->Y);
+	BestShelf->UsedWidth += Width;
+	return true;
+}
+
+FImageAtlas::FPage& FImageAtlas::AddPage()
+{
+	if (Pages.Num() == 0)
+	{
+		PageSize = FMath::RoundUpToPowerOfTwo(FMath::Clamp(GetDefault<UReactorUMGSetting>()->ImageAtlasPageSize, 256, 4096));
+	}
+
+	TArray64<uint8> Pixels;
+	Pixels.SetNumZeroed(static_cast<int64>(PageSize) * PageSize * AtlasBytesPerPixel);
+
+	FPage& Page = Pages.AddDefaulted_GetRef();
+	Page.Texture = UTexture2D::CreateTransient(PageSize, PageSize, PF_B8G8R8A8, NAME_None, Pixels);
+	if (Page.Texture)
+	{
+		Page.Texture->SRGB = true;
+		Page.Texture->UpdateResource();
+	}
+	return Page;
+}
+
+void FImageAtlas::Upload(UTexture2D* Texture, const FDecodedImage& Image, const FIntPoint& Position)
+{
+	const int32 SlotWidth = Image.SizeX + 2 * AtlasPadding;
+	const int32 SlotHeight = Image.SizeY + 2 * AtlasPadding;
+	const int32 SourcePitch = Image.SizeX * AtlasBytesPerPixel;
+	const int32 SlotPitch = SlotWidth * AtlasBytesPerPixel;
+
+	// freed by the render thread once the region is copied
+	uint8* SlotPixels = static_cast<uint8*>(FMemory::Malloc(static_cast<SIZE_T>(SlotPitch) * SlotHeight));
+	const uint8* Source = Image.Mips[0].GetData();
+	for (int32 Y = 0; Y < SlotHeight; ++Y)
+	{
+		const int32 SourceY = FMath::Clamp(Y - AtlasPadding, 0, Image.SizeY - 1);
+		const uint8* SourceRow = Source + static_cast<SIZE_T>(SourceY) * SourcePitch;
+		uint8* SlotRow = SlotPixels + static_cast<SIZE_T>(Y) * SlotPitch;
+		FMemory::Memcpy(SlotRow + AtlasPadding * AtlasBytesPerPixel, SourceRow, SourcePitch);
+		for (int32 X = 0; X < AtlasPadding; ++X)
+		{
+			FMemory::Memcpy(SlotRow + X * AtlasBytesPerPixel, SourceRow, AtlasBytesPerPixel);
+			FMemory::Memcpy(SlotRow + (SlotWidth - 1 - X) * AtlasBytesPerPixel, SourceRow + SourcePitch - AtlasBytesPerPixel,
+				AtlasBytesPerPixel);
+		}
+	}
+
+	FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(Position.X, Position.Y, 0, 0, SlotWidth, SlotHeight);
+	Texture->UpdateTextureRegions(0, 1, Region, SlotPitch, AtlasBytesPerPixel, SlotPixels,
+		[](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+		{
+			FMemory::Free(SrcData);
+			delete Regions;
+		});
+}
+
+void FImageAtlas::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (FPage& Page : Pages)
+	{
+		Collector.AddReferencedObject(Page.Texture);
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+
+struct FDecodedImage;
+class UTexture2D;
+class UReactorAtlasImage;
+
+/**
+ * Packs small runtime loaded images into shared BGRA8 pages, so icon grids with many distinct images
+ * batch into a handful of draws instead of one per texture.
+ * Pages are filled shelf by shelf, a page is recycled as a whole once every image on it has been destroyed.
+ * Opt in with UReactorUMGSetting::bUseImageAtlas. Game thread only.
+ */
+class FImageAtlas : public FGCObject
+{
+public:
+	static FImageAtlas& Get();
+
+	/**
+	 * @return the largest width/height packed into the atlas, 0 if the atlas is disabled
+	 */
+	int32 GetMaxImageSize() const;
+
+	/**
+	 * @return nullptr if the image is too large for the atlas or the atlas is disabled
+	 */
+	UReactorAtlasImage* Add(const FDecodedImage& Image);
+
+	void Release(int32 PageIndex);
+
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+
+	virtual FString GetReferencerName() const override
+	{
+		return TEXT("FImageAtlas");
+	}
+
+private:
+	struct FShelf
+	{
+		int32 Y = 0;
+		int32 Height = 0;
+		int32 UsedWidth = 0;
+	};
+
+	struct FPage
+	{
+		TObjectPtr<UTexture2D> Texture;
+		TArray<FShelf> Shelves;
+		int32 UsedHeight = 0;
+		int32 NumImages = 0;
+	};
+
+	bool Allocate(FPage& Page, int32 Width, int32 Height, FIntPoint& OutPosition) const;
+
+	FPage& AddPage();
+
+	static void Upload(UTexture2D* Texture, const FDecodedImage& Image, const FIntPoint& Position);
+
+	TArray<FPage> Pages;
+
+	int32 PageSize = 0;
+};
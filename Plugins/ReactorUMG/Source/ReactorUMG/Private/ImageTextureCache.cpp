@@ -0,0 +1,281 @@
+#include "ImageTextureCache.h"
+#include "ReactorAtlasImage.h"
+#include "HttpModule.h"
+#include "LogReactorUMG.h"
+#include "ReactorUMGSetting.h"
+#include "Async/Async.h"
+#include "Engine/Texture2D.h"
+#include "Hash/CityHash.h"
+#include "HAL/FileManager.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+void SaveCacheFileAsync(const FString& FilePath, TArray<uint8>&& Bytes, const FString& ETagFile, const FString& ETag)
+{
+	// both files are written to a unique temp file first, a crash in between must not leave a truncated file behind.
+	// the old ETag goes before the image is replaced and the new one is renamed in after it,
+	// so an ETag on disk always belongs to the image next to it
+	Async(EAsyncExecution::ThreadPool, [FilePath, Bytes = MoveTemp(Bytes), ETagFile, ETag]()
+	{
+		IFileManager& FileManager = IFileManager::Get();
+		const FString TempSuffix = TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+		const FString TempFile = FilePath + TempSuffix;
+		if (!FFileHelper::SaveArrayToFile(Bytes, *TempFile))
+		{
+			return;
+		}
+
+		FileManager.Delete(*ETagFile, false, true, true);
+		if (!FileManager.Move(*FilePath, *TempFile, true, true, false, true))
+		{
+			FileManager.Delete(*TempFile, false, true, true);
+			return;
+		}
+
+		const FString TempETagFile = ETagFile + TempSuffix;
+		if (!ETag.IsEmpty() && FFileHelper::SaveStringToFile(ETag, *TempETagFile))
+		{
+			FileManager.Move(*ETagFile, *TempETagFile, true, true, false, true);
+		}
+	});
+}
+}
+
+FImageTextureCache& FImageTextureCache::Get()
+{
+	static FImageTextureCache Instance;
+	return Instance;
+}
+
+void FImageTextureCache::LoadFile(const FString& FilePath, UObject* User, bool bIsSyncLoad,
+	FImageTextureLoader::FOnTextureLoaded OnLoaded)
+{
+	FString FullPath = FPaths::ConvertRelativePathToFull(FilePath);
+	FPaths::NormalizeFilename(FullPath);
+	const FString Key = FullPath + TEXT("|") + LexToString(IFileManager::Get().GetTimeStamp(*FullPath).GetTicks());
+
+	if (UObject* Resource = Find(Key, User))
+	{
+		OnLoaded(Resource);
+		return;
+	}
+
+	if (bIsSyncLoad)
+	{
+		UObject* Resource = FImageTextureLoader::LoadFile(FullPath);
+		if (Resource)
+		{
+			Add(Key, Resource, User);
+		}
+		OnLoaded(Resource);
+		return;
+	}
+
+	if (AddPendingRequest(Key, User, MoveTemp(OnLoaded)))
+	{
+		FImageTextureLoader::LoadFileAsync(FullPath, [this, Key](UObject* Resource)
+		{
+			FinishPendingRequests(Key, Resource);
+		});
+	}
+}
+
+void FImageTextureCache::LoadUrl(const FString& Url, UObject* User, FImageTextureLoader::FOnTextureLoaded OnLoaded)
+{
+	if (UObject* Resource = Find(Url, User))
+	{
+		OnLoaded(Resource);
+		return;
+	}
+
+	if (AddPendingRequest(Url, User, MoveTemp(OnLoaded)))
+	{
+		DownloadUrl(Url);
+	}
+}
+
+void FImageTextureCache::DownloadUrl(const FString& Url)
+{
+	const bool bUseDiskCache = GetDefault<UReactorUMGSetting>()->bCacheDownloadedImages;
+	const FString CacheFile = GetDiskCacheFile(Url);
+	const FString ETagFile = CacheFile + TEXT(".etag");
+
+	FString ETag;
+	const bool bHasCacheFile = bUseDiskCache && FPaths::FileExists(CacheFile);
+	if (bHasCacheFile)
+	{
+		FFileHelper::LoadFileToString(ETag, *ETagFile);
+	}
+
+	FHttpModule& HTTP = FHttpModule::Get();
+	TSharedRef<IHttpRequest> HttpRequest = HTTP.CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindLambda(
+		[this, Url, CacheFile, ETagFile, bUseDiskCache, bHasCacheFile](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+		{
+			check(IsInGameThread());
+			auto OnTextureLoaded = [this, Url](UObject* Resource)
+			{
+				FinishPendingRequests(Url, Resource);
+			};
+
+			const int32 ResponseCode = Response.IsValid() ? Response->GetResponseCode() : 0;
+			if (bHasCacheFile && (ResponseCode == EHttpResponseCodes::NotModified || !bWasSuccessful || !Response.IsValid()))
+			{
+				// unchanged on the server, or offline, the copy on disk is the best we have
+				FImageTextureLoader::LoadFileAsync(CacheFile, OnTextureLoaded);
+				return;
+			}
+
+			if (!bWasSuccessful || !Response.IsValid() || !EHttpResponseCodes::IsOk(ResponseCode))
+			{
+				UE_LOG(LogReactorUMG, Error, TEXT("Failed to download image from url: %s"), *Url);
+				FinishPendingRequests(Url, nullptr);
+				return;
+			}
+
+			UE_LOG(LogReactorUMG, Log, TEXT("Download image file successfully for url: %s"), *Url);
+			TArray<uint8> ImageData = Response->GetContent();
+			if (bUseDiskCache)
+			{
+				SaveCacheFileAsync(CacheFile, TArray<uint8>(ImageData), ETagFile, Response->GetHeader(TEXT("ETag")));
+			}
+
+			FImageTextureLoader::LoadBufferAsync(MoveTemp(ImageData), OnTextureLoaded);
+		});
+
+	if (!ETag.IsEmpty())
+	{
+		HttpRequest->SetHeader(TEXT("If-None-Match"), ETag);
+	}
+	HttpRequest->SetURL(Url);
+	HttpRequest->SetVerb("GET");
+	HttpRequest->ProcessRequest();
+}
+
+FString FImageTextureCache::GetDiskCacheFile(const FString& Url) const
+{
+	const uint64 UrlHash = CityHash64(reinterpret_cast<const char*>(*Url), Url.Len() * sizeof(TCHAR));
+	return FPaths::ProjectSavedDir() / TEXT("ReactorUMG") / TEXT("ImageCache") / FString::Printf(TEXT("%016llx.img"), UrlHash);
+}
+
+UObject* FImageTextureCache::Find(const FString& Key, UObject* User)
+{
+	FEntry* Entry = Entries.Find(Key);
+	if (!Entry || !Entry->Resource)
+	{
+		return nullptr;
+	}
+
+	Entry->LastUsedTime = FPlatformTime::Seconds();
+	if (User)
+	{
+		Entry->Users.RemoveAllSwap([](const TWeakObjectPtr<UObject>& WeakUser) { return !WeakUser.IsValid(); });
+		Entry->Users.AddUnique(User);
+	}
+	return Entry->Resource;
+}
+
+void FImageTextureCache::Add(const FString& Key, UObject* Resource, UObject* User)
+{
+	FEntry& Entry = Entries.FindOrAdd(Key);
+	TotalMemorySize -= Entry.MemorySize;
+
+	Entry.Resource = Resource;
+	if (const UTexture2D* Texture = Cast<UTexture2D>(Resource))
+	{
+		Entry.MemorySize = Texture->CalcTextureMemorySizeEnum(TMC_AllMips);
+	}
+	else if (const UReactorAtlasImage* AtlasImage = Cast<UReactorAtlasImage>(Resource))
+	{
+		Entry.MemorySize = AtlasImage->GetMemorySize();
+	}
+	Entry.LastUsedTime = FPlatformTime::Seconds();
+	if (User)
+	{
+		Entry.Users.AddUnique(User);
+	}
+	TotalMemorySize += Entry.MemorySize;
+
+	EvictOverBudget();
+}
+
+bool FImageTextureCache::AddPendingRequest(const FString& Key, UObject* User, FImageTextureLoader::FOnTextureLoaded&& OnLoaded)
+{
+	TArray<FPendingRequest>* Requests = PendingRequests.Find(Key);
+	const bool bStartLoad = Requests == nullptr;
+	if (bStartLoad)
+	{
+		Requests = &PendingRequests.Add(Key);
+	}
+
+	Requests->Add({ User, MoveTemp(OnLoaded) });
+	return bStartLoad;
+}
+
+void FImageTextureCache::FinishPendingRequests(const FString& Key, UObject* Resource)
+{
+	TArray<FPendingRequest> Requests;
+	PendingRequests.RemoveAndCopyValue(Key, Requests);
+
+	if (Resource)
+	{
+		Add(Key, Resource, nullptr);
+		FEntry& Entry = Entries[Key];
+		for (const FPendingRequest& Request : Requests)
+		{
+			if (Request.User.IsValid())
+			{
+				Entry.Users.AddUnique(Request.User);
+			}
+		}
+	}
+
+	for (const FPendingRequest& Request : Requests)
+	{
+		Request.OnLoaded(Resource);
+	}
+}
+
+void FImageTextureCache::EvictOverBudget()
+{
+	const int64 Budget = static_cast<int64>(FMath::Max(GetDefault<UReactorUMGSetting>()->ImageTextureCacheBudgetMB, 0)) * 1024 * 1024;
+	if (TotalMemorySize <= Budget)
+	{
+		return;
+	}
+
+	TArray<TPair<double, FString>> Candidates;
+	for (auto& Pair : Entries)
+	{
+		Pair.Value.Users.RemoveAllSwap([](const TWeakObjectPtr<UObject>& WeakUser) { return !WeakUser.IsValid(); });
+		if (Pair.Value.Users.Num() == 0)
+		{
+			Candidates.Emplace(Pair.Value.LastUsedTime, Pair.Key);
+		}
+	}
+	Candidates.Sort([](const TPair<double, FString>& A, const TPair<double, FString>& B) { return A.Key < B.Key; });
+
+	for (const TPair<double, FString>& Candidate : Candidates)
+	{
+		if (TotalMemorySize <= Budget)
+		{
+			break;
+		}
+
+		FEntry Entry;
+		Entries.RemoveAndCopyValue(Candidate.Value, Entry);
+		TotalMemorySize -= Entry.MemorySize;
+	}
+}
+
+void FImageTextureCache::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (auto& Pair : Entries)
+	{
+		Collector.AddReferencedObject(Pair.Value.Resource);
+	}
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ImageTextureLoader.h"
+#include "UObject/GCObject.h"
+
+/**
+ * Process wide cache of the brush resources (textures or atlas images) created for image brushes,
+ * the same file or url is decoded once and handed to every widget showing it.
+ * Files are keyed by absolute path and modification time, urls by the url itself. Downloaded images are
+ * also kept on disk and revalidated with their ETag, so later launches skip the download when unchanged.
+ * Resources whose users have all been destroyed are evicted least recently used first once the memory budget
+ * is exceeded, brushes still referencing an evicted resource keep it alive themselves.
+ * Game thread only.
+ */
+class FImageTextureCache : public FGCObject
+{
+public:
+	static FImageTextureCache& Get();
+
+	/**
+	 * @param User object showing the texture, the texture is not evicted while a user is alive
+	 * @param OnLoaded called with nullptr if the file can not be decoded, synchronously on a cache hit or a sync load
+	 */
+	void LoadFile(const FString& FilePath, UObject* User, bool bIsSyncLoad, FImageTextureLoader::FOnTextureLoaded OnLoaded);
+
+	void LoadUrl(const FString& Url, UObject* User, FImageTextureLoader::FOnTextureLoaded OnLoaded);
+
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+
+	virtual FString GetReferencerName() const override
+	{
+		return TEXT("FImageTextureCache");
+	}
+
+private:
+	struct FEntry
+	{
+		TObjectPtr<UObject> Resource;
+		TArray<TWeakObjectPtr<UObject>> Users;
+		int64 MemorySize = 0;
+		double LastUsedTime = 0;
+	};
+
+	struct FPendingRequest
+	{
+		TWeakObjectPtr<UObject> User;
+		FImageTextureLoader::FOnTextureLoaded OnLoaded;
+	};
+
+	/**
+	 * @return the cached resource and mark User as using it
+	 */
+	UObject* Find(const FString& Key, UObject* User);
+
+	void Add(const FString& Key, UObject* Resource, UObject* User);
+
+	/**
+	 * Queue the request behind a load of the same key already in flight
+	 * @return true if the caller has to start the load
+	 */
+	bool AddPendingRequest(const FString& Key, UObject* User, FImageTextureLoader::FOnTextureLoaded&& OnLoaded);
+
+	void FinishPendingRequests(const FString& Key, UObject* Resource);
+
+	void EvictOverBudget();
+
+	void DownloadUrl(const FString& Url);
+
+	FString GetDiskCacheFile(const FString& Url) const;
+
+	TMap<FString, FEntry> Entries;
+
+	TMap<FString, TArray<FPendingRequest>> PendingRequests;
+
+	int64 TotalMemorySize = 0;
+};
@@ -0,0 +1,184 @@
+#include "ImageTextureLoader.h"
+#include "ImageAtlas.h"
+#include "LogReactorUMG.h"
+#include "ReactorUMGSetting.h"
+#include "Async/Async.h"
+#include "Engine/Texture2D.h"
+#include "IImageWrapperModule.h"
+#include "ImageCore.h"
+#include "Misc/FileHelper.h"
+#include "Modules/ModuleManager.h"
+#include "TextureResource.h"
+
+IImageWrapperModule& FImageTextureLoader::GetImageWrapperModule()
+{
+	check(IsInGameThread());
+	return FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName(TEXT("ImageWrapper")));
+}
+
+FImageTextureLoader::FDecodeOptions FImageTextureLoader::GetDecodeOptions()
+{
+	const UReactorUMGSetting* Setting = GetDefault<UReactorUMGSetting>();
+	FDecodeOptions Options;
+	Options.bGenerateMips = Setting->bGenerateImageMips;
+	Options.MaxAtlasImageSize = FImageAtlas::Get().GetMaxImageSize();
+	return Options;
+}
+
+UObject* FImageTextureLoader::LoadFile(const FString& FilePath)
+{
+	FDecodedImage Image;
+	if (!DecodeFile(GetImageWrapperModule(), FilePath, GetDecodeOptions(), Image))
+	{
+		return nullptr;
+	}
+
+	return CreateResource(Image);
+}
+
+UObject* FImageTextureLoader::LoadBuffer(const TArray<uint8>& Buffer)
+{
+	FDecodedImage Image;
+	if (!Decode(GetImageWrapperModule(), Buffer, GetDecodeOptions(), Image))
+	{
+		return nullptr;
+	}
+
+	return CreateResource(Image);
+}
+
+void FImageTextureLoader::LoadFileAsync(const FString& FilePath, FOnTextureLoaded OnLoaded)
+{
+	IImageWrapperModule* ImageWrapperModule = &GetImageWrapperModule();
+	const FDecodeOptions Options = GetDecodeOptions();
+	Async(EAsyncExecution::TaskGraph, [FilePath, ImageWrapperModule, Options, OnLoaded = MoveTemp(OnLoaded)]()
+	{
+		TSharedPtr<FDecodedImage> Image = MakeShared<FDecodedImage>();
+		if (!DecodeFile(*ImageWrapperModule, FilePath, Options, *Image))
+		{
+			Image.Reset();
+		}
+
+		FinishAsync(Image, OnLoaded);
+	});
+}
+
+void FImageTextureLoader::LoadBufferAsync(TArray<uint8>&& Buffer, FOnTextureLoaded OnLoaded)
+{
+	IImageWrapperModule* ImageWrapperModule = &GetImageWrapperModule();
+	const FDecodeOptions Options = GetDecodeOptions();
+	Async(EAsyncExecution::TaskGraph, [Buffer = MoveTemp(Buffer), ImageWrapperModule, Options, OnLoaded = MoveTemp(OnLoaded)]()
+	{
+		TSharedPtr<FDecodedImage> Image = MakeShared<FDecodedImage>();
+		if (!Decode(*ImageWrapperModule, Buffer, Options, *Image))
+		{
+			Image.Reset();
+		}
+
+		FinishAsync(Image, OnLoaded);
+	});
+}
+
+void FImageTextureLoader::FinishAsync(TSharedPtr<FDecodedImage> Image, FOnTextureLoaded OnLoaded)
+{
+	AsyncTask(ENamedThreads::GameThread, [Image, OnLoaded]()
+	{
+		OnLoaded(Image.IsValid() ? CreateResource(*Image) : nullptr);
+	});
+}
+
+bool FImageTextureLoader::Decode(IImageWrapperModule& ImageWrapperModule, const TArray<uint8>& Buffer, const FDecodeOptions& Options,
+	FDecodedImage& OutImage)
+{
+	FImage Image;
+	if (Buffer.Num() == 0 || !ImageWrapperModule.DecompressImage(Buffer.GetData(), Buffer.Num(), Image))
+	{
+		UE_LOG(LogReactorUMG, Error, TEXT("Failed to decode image, the format is not supported or the data is corrupted"));
+		return false;
+	}
+
+	// the same layout ImportFileAsTexture2D produces for 8 bit images, HDR sources are tone mapped by the conversion
+	Image.ChangeFormat(ERawImageFormat::BGRA8, EGammaSpace::sRGB);
+
+	OutImage.SizeX = Image.SizeX;
+	OutImage.SizeY = Image.SizeY;
+	OutImage.Mips.Reset();
+	OutImage.Mips.Add(MoveTemp(Image.RawData));
+	const bool bFitsAtlas = OutImage.SizeX <= Options.MaxAtlasImageSize && OutImage.SizeY <= Options.MaxAtlasImageSize;
+	if (!Options.bGenerateMips || bFitsAtlas)
+	{
+		return true;
+	}
+
+	// each level is filtered from the full size image, resizing the previous level would accumulate blur
+	FImage Source(OutImage.SizeX, OutImage.SizeY, ERawImageFormat::BGRA8, EGammaSpace::sRGB);
+	Source.RawData = OutImage.Mips[0];
+	int32 MipSizeX = OutImage.SizeX;
+	int32 MipSizeY = OutImage.SizeY;
+	while (MipSizeX > 1 || MipSizeY > 1)
+	{
+		MipSizeX = FMath::Max(MipSizeX / 2, 1);
+		MipSizeY = FMath::Max(MipSizeY / 2, 1);
+
+		FImage Mip;
+		Source.ResizeTo(Mip, MipSizeX, MipSizeY, ERawImageFormat::BGRA8, EGammaSpace::sRGB);
+		OutImage.Mips.Add(MoveTemp(Mip.RawData));
+	}
+
+	return true;
+}
+
+bool FImageTextureLoader::DecodeFile(IImageWrapperModule& ImageWrapperModule, const FString& FilePath, const FDecodeOptions& Options,
+	FDecodedImage& OutImage)
+{
+	TArray<uint8> Buffer;
+	if (!FFileHelper::LoadFileToArray(Buffer, *FilePath))
+	{
+		UE_LOG(LogReactorUMG, Error, TEXT("Failed to read image file: %s"), *FilePath);
+		return false;
+	}
+
+	return Decode(ImageWrapperModule, Buffer, Options, OutImage);
+}
+
+UObject* FImageTextureLoader::CreateResource(const FDecodedImage& Image)
+{
+	if (UObject* AtlasImage = FImageAtlas::Get().Add(Image))
+	{
+		return AtlasImage;
+	}
+
+	return CreateTexture(Image);
+}
+
+UTexture2D* FImageTextureLoader::CreateTexture(const FDecodedImage& Image)
+{
+	check(IsInGameThread());
+	if (Image.Mips.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	UTexture2D* Texture = UTexture2D::CreateTransient(Image.SizeX, Image.SizeY, PF_B8G8R8A8, NAME_None, Image.Mips[0]);
+	if (!Texture)
+	{
+		return nullptr;
+	}
+
+	FTexturePlatformData* PlatformData = Texture->GetPlatformData();
+	for (int32 MipIndex = 1; MipIndex < Image.Mips.Num(); ++MipIndex)
+	{
+		const TArray64<uint8>& MipData = Image.Mips[MipIndex];
+		FTexture2DMipMap* Mip = new FTexture2DMipMap(FMath::Max(Image.SizeX >> MipIndex, 1), FMath::Max(Image.SizeY >> MipIndex, 1), 1);
+		PlatformData->Mips.Add(Mip);
+
+		Mip->BulkData.Lock(LOCK_READ_WRITE);
+		FMemory::Memcpy(Mip->BulkData.Realloc(MipData.Num()), MipData.GetData(), MipData.Num());
+		Mip->BulkData.Unlock();
+	}
+
+	Texture->SRGB = true;
+	// the pixels are uploaded by the render thread
+	Texture->UpdateResource();
+	return Texture;
+}
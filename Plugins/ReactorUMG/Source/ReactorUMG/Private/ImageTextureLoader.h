@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UTexture2D;
+class IImageWrapperModule;
+
+/**
+ * Decoded BGRA8 sRGB pixels of an image file, Mips[0] is the full size level.
+ */
+struct FDecodedImage
+{
+	int32 SizeX = 0;
+	int32 SizeY = 0;
+	TArray<TArray64<uint8>> Mips;
+};
+
+/**
+ * Turns PNG/JPEG/BMP/TGA/EXR/HDR files or buffers into brush resources: a transient texture, or a region of a
+ * shared atlas page (UReactorAtlasImage) for small images when the image atlas is enabled.
+ * Asynchronous loads read, decode and build the mip chain on the task graph,
+ * only the texture object and its resource are created on the game thread.
+ */
+class FImageTextureLoader
+{
+public:
+	using FOnTextureLoaded = TFunction<void(UObject* Resource)>;
+
+	static UObject* LoadFile(const FString& FilePath);
+
+	static UObject* LoadBuffer(const TArray<uint8>& Buffer);
+
+	/**
+	 * @param OnLoaded called on the game thread, Resource is nullptr if the file can not be read or decoded
+	 */
+	static void LoadFileAsync(const FString& FilePath, FOnTextureLoaded OnLoaded);
+
+	static void LoadBufferAsync(TArray<uint8>&& Buffer, FOnTextureLoaded OnLoaded);
+
+	struct FDecodeOptions
+	{
+		bool bGenerateMips = false;
+		// images up to this size go to the atlas and need no mips, 0 if the atlas is disabled
+		int32 MaxAtlasImageSize = 0;
+	};
+
+	/**
+	 * Options of brush images from the settings, game thread only
+	 */
+	static FDecodeOptions GetDecodeOptions();
+
+	/**
+	 * Loads the module on first use, game thread only
+	 */
+	static IImageWrapperModule& GetImageWrapperModule();
+
+	/**
+	 * Thread safe, ImageWrapperModule has to be loaded on the game thread beforehand
+	 */
+	static bool Decode(IImageWrapperModule& ImageWrapperModule, const TArray<uint8>& Buffer, const FDecodeOptions& Options, FDecodedImage& OutImage);
+
+	static bool DecodeFile(IImageWrapperModule& ImageWrapperModule, const FString& FilePath, const FDecodeOptions& Options, FDecodedImage& OutImage);
+
+	/**
+	 * Always a standalone texture, the image atlas is bypassed
+	 */
+	static UTexture2D* CreateTexture(const FDecodedImage& Image);
+
+private:
+	static UObject* CreateResource(const FDecodedImage& Image);
+
+	static void FinishAsync(TSharedPtr<FDecodedImage> Image, FOnTextureLoaded OnLoaded);
+};
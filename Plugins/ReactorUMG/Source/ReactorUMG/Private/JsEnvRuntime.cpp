@@ -4,6 +4,11 @@
 #include "LogReactorUMG.h"
 #include "ReactorUtils.h"
 #include "PuertsSetting.h"
+#include "JsEnvSnapshot.h"
+#include "ReactorUMGSetting.h"
+#include "Misc/FileHelper.h"
+#include "Hash/CityHash.h"
+#include "Internationalization/Regex.h"
 
 void FReactorUMGJSLogger::Log(const FString& Message) const
 {
@@ -33,41 +38,180 @@ void FReactorUMGJSLogger::Info(const FString& Message) const
 	UE_LOG(LogReactorUMG, Display, TEXT("%s"), *Message)
 }
 
-FJsEnvRuntime::FJsEnvRuntime(int32 EnvPoolSize)
+FJsEnvRuntime::FJsEnvRuntime()
 {
-	int32 DebugPort = GetDefault<UPuertsSetting>()->DebugPort;
 	ReactorUmgLogger = std::make_shared<FReactorUMGJSLogger>();
-	this->EnvPoolSize = EnvPoolSize;
-	for (int32 i = 0; i < EnvPoolSize; i++)
+	LoadStartupSnapshot();
+	// the first env is needed right away, the other warm ones are created by Tick
+	IdleJsEnvs.Add(CreateJsEnv());
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FJsEnvRuntime::Tick));
+}
+
+FJsEnvRuntime::FPooledJsEnv FJsEnvRuntime::CreateJsEnv()
+{
+	// reuse the debug ports of evicted envs
+	int32 DebugPortOffset = UsedDebugPortOffsets.Find(false);
+	if (DebugPortOffset == INDEX_NONE)
+	{
+		DebugPortOffset = UsedDebugPortOffsets.Add(true);
+	}
+	else
 	{
-		TSharedPtr<puerts::FJsEnv> JsEnv = MakeShared<puerts::FJsEnv>(
+		UsedDebugPortOffsets[DebugPortOffset] = true;
+	}
+
+	const int32 DebugPort = GetDefault<UPuertsSetting>()->DebugPort + DebugPortOffset + 3;
+	FPooledJsEnv PooledJsEnv;
+	PooledJsEnv.JsEnv = MakeShared<puerts::FJsEnv>(
 		std::make_unique<puerts::DefaultJSModuleLoader>(TEXT("JavaScript")),
-		ReactorUmgLogger, DebugPort + i + 3);
-		JsRuntimeEnvPool.Add(JsEnv, 0);
+		ReactorUmgLogger, DebugPort, nullptr, FString(), nullptr, nullptr, StartupSnapshot);
+	PooledJsEnv.DebugPortOffset = DebugPortOffset;
+	PooledJsEnv.LastReleaseTime = FPlatformTime::Seconds();
+	PooledJsEnv.bUsed = false;
+	return PooledJsEnv;
+}
+
+bool FJsEnvRuntime::Tick(float DeltaTime)
+{
+	const UReactorUMGSetting* Setting = GetDefault<UReactorUMGSetting>();
+	const int32 MaxJsEnvs = FMath::Max(Setting->MaxJsEnvs, 1);
+	const int32 MinWarmJsEnvs = FMath::Clamp(Setting->MinWarmJsEnvs, 0, MaxJsEnvs);
+
+	// waiters retry GetFreeJsEnv themselves, only wake up as many as can succeed
+	int32 NumAvailable = IdleJsEnvs.Num() + FMath::Max(MaxJsEnvs - NumJsEnvs(), 0);
+	while (Waiters.Num() > 0 && NumAvailable-- > 0)
+	{
+		TFunction<void()> Waiter = MoveTemp(Waiters[0]);
+		Waiters.RemoveAt(0);
+		Waiter();
+	}
+
+	if (IdleJsEnvs.Num() < MinWarmJsEnvs && NumJsEnvs() < MaxJsEnvs)
+	{
+		// one env per frame at most, so refilling the pool does not become a hitch of its own
+		IdleJsEnvs.Add(CreateJsEnv());
+	}
+	else if (IdleJsEnvs.Num() > MinWarmJsEnvs && Setting->JsEnvIdleEvictSeconds > 0)
+	{
+		// bridge callers stay bound to functions of the env that started their script,
+		// so only spares that never ran anything can be dropped
+		const double Now = FPlatformTime::Seconds();
+		const int32 Index = IdleJsEnvs.IndexOfByPredicate([&](const FPooledJsEnv& PooledJsEnv)
+		{
+			return !PooledJsEnv.bUsed && Now - PooledJsEnv.LastReleaseTime > Setting->JsEnvIdleEvictSeconds;
+		});
+		if (Index != INDEX_NONE)
+		{
+			UsedDebugPortOffsets[IdleJsEnvs[Index].DebugPortOffset] = false;
+			IdleJsEnvs.RemoveAt(Index);
+		}
 	}
+
+	return true;
+}
+
+FString FJsEnvRuntime::GetStartupSnapshotPath(const FString& NodeEnv)
+{
+	// the blob only fits the V8 build and platform that produced it
+	return FPaths::Combine(FPaths::ProjectContentDir(), TEXT("JavaScript"), TEXT("snapshot"),
+		FString(FPlatformProperties::IniPlatformName()) + TEXT("-") + NodeEnv + TEXT(".bin"));
+}
+
+FString FJsEnvRuntime::GetStartupSnapshotNodeEnv()
+{
+	// must match the process.env the polyfill of every env sets up
+	return puerts::FJsEnvSnapshot::GetNodeEnv();
+}
+
+void FJsEnvRuntime::LoadStartupSnapshot()
+{
+	StartupSnapshot.reset();
+	if (!GetDefault<UReactorUMGSetting>()->bUseJsStartupSnapshot)
+	{
+		return;
+	}
+
+	const FString SnapshotPath = GetStartupSnapshotPath(GetStartupSnapshotNodeEnv());
+	if (!FPaths::FileExists(SnapshotPath))
+	{
+		return;
+	}
+
+	auto Blob = std::make_shared<TArray<uint8>>();
+	if (FFileHelper::LoadFileToArray(*Blob, *SnapshotPath))
+	{
+		StartupSnapshot = Blob;
+	}
+	else
+	{
+		UE_LOG(LogReactorUMG, Warning, TEXT("Failed to load startup snapshot %s"), *SnapshotPath);
+	}
+}
+
+bool FJsEnvRuntime::BuildStartupSnapshot(FString& OutError)
+{
+	// only self-contained packages, reactorUMG itself needs `ue` bindings which can not be serialized
+	static const TArray<FString> SnapshotModules = { TEXT("react"), TEXT("react-reconciler") };
+	// scheduler captures setTimeout/MessageChannel while evaluated, react-reconciler requires it once a renderer is created
+	static const TArray<FString> ExternalModules = { TEXT("scheduler") };
+	// the editor builds the snapshot the Shipping builds boot from too
+	static const TArray<FString> NodeEnvs = { TEXT("development"), TEXT("production") };
+
+	for (const FString& NodeEnv : NodeEnvs)
+	{
+		TArray<uint8> Blob;
+		if (!puerts::FJsEnvSnapshot::Create(std::make_shared<puerts::DefaultJSModuleLoader>(TEXT("JavaScript")),
+			SnapshotModules, ExternalModules, NodeEnv, Blob, OutError))
+		{
+			return false;
+		}
+
+		const FString SnapshotPath = GetStartupSnapshotPath(NodeEnv);
+		if (!FFileHelper::SaveArrayToFile(Blob, *SnapshotPath))
+		{
+			OutError = FString::Printf(TEXT("can not write %s"), *SnapshotPath);
+			return false;
+		}
+
+		UE_LOG(LogReactorUMG, Display, TEXT("Startup snapshot written to %s (%d bytes)"), *SnapshotPath, Blob.Num());
+	}
+	RebuildRuntimePool();
+	return true;
 }
 
 FJsEnvRuntime::~FJsEnvRuntime()
 {
-	JsRuntimeEnvPool.Empty();
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	Waiters.Empty();
+	IdleJsEnvs.Empty();
+	BusyJsEnvs.Empty();
 }
 
 TSharedPtr<puerts::FJsEnv> FJsEnvRuntime::GetFreeJsEnv()
 {
-	TSharedPtr<puerts::FJsEnv> JsEnv = nullptr;
-	for (auto& Pair : JsRuntimeEnvPool)
+	if (IdleJsEnvs.Num() == 0)
 	{
-		if (Pair.Value == 0)
+		if (NumJsEnvs() >= FMath::Max(GetDefault<UReactorUMGSetting>()->MaxJsEnvs, 1))
 		{
-			JsEnv = Pair.Key;
-			Pair.Value = 1;
-			break;
+			return nullptr;
 		}
+
+		UE_LOG(LogReactorUMG, Log, TEXT("All %d javascript envs are busy, create a new one"), NumJsEnvs());
+		IdleJsEnvs.Add(CreateJsEnv());
 	}
 
+	FPooledJsEnv PooledJsEnv = IdleJsEnvs.Pop(EAllowShrinking::No);
+	PooledJsEnv.bUsed = true;
+	TSharedPtr<puerts::FJsEnv> JsEnv = PooledJsEnv.JsEnv;
+	BusyJsEnvs.Add(MoveTemp(PooledJsEnv));
 	return JsEnv;
 }
 
+void FJsEnvRuntime::WaitForFreeJsEnv(TFunction<void()> OnMaybeFree)
+{
+	Waiters.Add(MoveTemp(OnMaybeFree));
+}
+
 bool FJsEnvRuntime::StartJavaScript(const TSharedPtr<puerts::FJsEnv>& JsEnv, const FString& Script, const TArray<TPair<FString, UObject*>>& Arguments) const
 {
 	if (JsEnv)
@@ -95,37 +239,31 @@ bool FJsEnvRuntime::CheckScriptLegal(const FString& Script) const
 
 void FJsEnvRuntime::ReleaseJsEnv(TSharedPtr<puerts::FJsEnv> JsEnv)
 {
-	for (auto& Pair : JsRuntimeEnvPool)
+	const int32 Index = BusyJsEnvs.IndexOfByPredicate([&](const FPooledJsEnv& PooledJsEnv)
 	{
-		auto Key = Pair.Key;
-		if (Key.Get() == JsEnv.Get())
-		{
-			JsEnv->Release();
-			Pair.Value = 0;
-			break;
-		}
+		return PooledJsEnv.JsEnv.Get() == JsEnv.Get();
+	});
+	if (Index == INDEX_NONE)
+	{
+		return;
 	}
+
+	FPooledJsEnv PooledJsEnv = MoveTemp(BusyJsEnvs[Index]);
+	BusyJsEnvs.RemoveAtSwap(Index);
+	JsEnv->Release();
+	PooledJsEnv.LastReleaseTime = FPlatformTime::Seconds();
+	IdleJsEnvs.Add(MoveTemp(PooledJsEnv));
 }
 
 void FJsEnvRuntime::RebuildRuntimePool()
 {
-	for (auto& Pair : JsRuntimeEnvPool)
-	{
-		auto Key = Pair.Key;
-		Key.Reset();
-	}
+	IdleJsEnvs.Empty();
+	BusyJsEnvs.Empty();
+	UsedDebugPortOffsets.Empty();
 
-	JsRuntimeEnvPool.Empty();
-
-	int32 DebugPort = GetDefault<UPuertsSetting>()->DebugPort;
 	ReactorUmgLogger = std::make_shared<FReactorUMGJSLogger>();
-	for (int32 i = 0; i < EnvPoolSize; i++)
-	{
-		TSharedPtr<puerts::FJsEnv> JsEnv = MakeShared<puerts::FJsEnv>(
-		std::make_unique<puerts::DefaultJSModuleLoader>(TEXT("JavaScript")),
-		ReactorUmgLogger, DebugPort + i + 3);
-		JsRuntimeEnvPool.Add(JsEnv, 0);
-	}
+	LoadStartupSnapshot();
+	IdleJsEnvs.Add(CreateJsEnv());
 }
 
 void FJsEnvRuntime::RestartJsScripts(
@@ -164,27 +302,158 @@ void FJsEnvRuntime::RestartJsScripts(
 		ModuleNames.Add(RelativePath, SourcePath);
 	}
 
-	// TODO@Caleb196x: 可以记录文件的hash值，通过对比hash值，当文件有修改时，才重新加载文件。
+	UpdateScriptFileInfos(ModuleNames);
+
+	TMap<FString, TArray<FString>> Dependents;
 	for (const auto& ModulePair : ModuleNames)
 	{
-		FString FileContent;
-		if (FReactorUtils::ReadFileContent(ModulePair.Value, FileContent))
+		for (const FString& Dependency : ScriptFileInfos[ModulePair.Value].Dependencies)
+		{
+			Dependents.FindOrAdd(Dependency).Add(ModulePair.Value);
+		}
+	}
+
+	// the main script is started in every env below, none of them may be evicted afterwards
+	TArray<TSharedPtr<puerts::FJsEnv>> AllJsEnvs;
+	for (TArray<FPooledJsEnv>* JsEnvs : { &IdleJsEnvs, &BusyJsEnvs })
+	{
+		for (FPooledJsEnv& PooledJsEnv : *JsEnvs)
 		{
-			for (auto& Pair : JsRuntimeEnvPool)
+			AllJsEnvs.Add(PooledJsEnv.JsEnv);
+
+			// an env that never ran a script has nothing cached, an env started before it had a manifest may cache anything
+			const bool bLoadedWithoutManifest = PooledJsEnv.bUsed && PooledJsEnv.ModuleHashes.Num() == 0;
+			PooledJsEnv.bUsed = true;
+
+			TArray<FString> ChangedModules;
+			if (bLoadedWithoutManifest || PooledJsEnv.ModuleHashes.Num() > 0)
 			{
-				auto Env = Pair.Key;
-				Env->ReloadModule(FName(*ModulePair.Key), FileContent);
-				Env->ForceReloadJsFile(ModulePair.Value);
+				for (const auto& ModulePair : ModuleNames)
+				{
+					const uint64* LastHash = PooledJsEnv.ModuleHashes.Find(ModulePair.Value);
+					if (bLoadedWithoutManifest || !LastHash || *LastHash != ScriptFileInfos[ModulePair.Value].Hash)
+					{
+						ChangedModules.Add(ModulePair.Key);
+					}
+				}
+			}
+
+			// modules requiring a changed one hold on to its old exports, they have to be evaluated again as well,
+			// the rest keep their cached exports when the main script is started again
+			TSet<FString> ModulesToEvaluate;
+			TArray<FString> Pending;
+			for (const FString& ModuleName : ChangedModules)
+			{
+				Pending.Add(ModuleNames[ModuleName]);
+			}
+			while (Pending.Num() > 0)
+			{
+				const FString SourcePath = Pending.Pop(EAllowShrinking::No);
+				bool bAlreadyAdded = false;
+				ModulesToEvaluate.Add(SourcePath, &bAlreadyAdded);
+				if (!bAlreadyAdded)
+				{
+					if (const TArray<FString>* ModuleDependents = Dependents.Find(SourcePath))
+					{
+						Pending.Append(*ModuleDependents);
+					}
+				}
+			}
+
+			for (const FString& ModuleName : ChangedModules)
+			{
+				const FString& SourcePath = ModuleNames[ModuleName];
+				FString FileContent;
+				if (FReactorUtils::ReadFileContent(SourcePath, FileContent))
+				{
+					PooledJsEnv.JsEnv->ReloadModule(FName(*ModuleName), FileContent);
+				}
+			}
+
+			for (const FString& SourcePath : ModulesToEvaluate)
+			{
+				PooledJsEnv.JsEnv->ForceReloadJsFile(SourcePath);
+			}
+
+			UE_LOG(LogReactorUMG, Verbose, TEXT("Reload %d changed script files, evaluate %d modules again"),
+				ChangedModules.Num(), ModulesToEvaluate.Num());
+
+			PooledJsEnv.ModuleHashes.Reset();
+			for (const auto& ModulePair : ModuleNames)
+			{
+				PooledJsEnv.ModuleHashes.Add(ModulePair.Value, ScriptFileInfos[ModulePair.Value].Hash);
 			}
 		}
 	}
 	
-	for (auto& Pair : JsRuntimeEnvPool)
+	for (const TSharedPtr<puerts::FJsEnv>& Env : AllJsEnvs)
 	{
-		auto Env = Pair.Key;
 		Env->Release();
 		Env->ForceReloadJsFile(MainJsScript);
 		Env->Start(MainJsScript, Arguments);
 		Env->Release();
 	}
-}
\ No newline at end of file
+}
+
+void FJsEnvRuntime::UpdateScriptFileInfos(const TMap<FString, FString>& ModuleNames)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	TSet<FString> SourcePaths;
+	for (const auto& ModulePair : ModuleNames)
+	{
+		SourcePaths.Add(ModulePair.Value);
+	}
+
+	for (auto It = ScriptFileInfos.CreateIterator(); It; ++It)
+	{
+		if (!SourcePaths.Contains(It.Key()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// only relative requires can point into the script home, packages live in node_modules
+	const FRegexPattern RequirePattern(TEXT("require\\s*\\(\\s*['\"](\\.{1,2}/[^'\"]+)['\"]\\s*\\)"));
+	for (const FString& SourcePath : SourcePaths)
+	{
+		const FFileStatData StatData = PlatformFile.GetStatData(*SourcePath);
+		FScriptFileInfo* Info = ScriptFileInfos.Find(SourcePath);
+		if (Info && StatData.bIsValid && Info->TimeStamp == StatData.ModificationTime && Info->FileSize == StatData.FileSize)
+		{
+			continue;
+		}
+
+		TArray<uint8> Content;
+		if (!FFileHelper::LoadFileToArray(Content, *SourcePath))
+		{
+			UE_LOG(LogReactorUMG, Error, TEXT("Failed to read file: %s"), *SourcePath);
+		}
+
+		FScriptFileInfo& NewInfo = ScriptFileInfos.Add(SourcePath);
+		NewInfo.TimeStamp = StatData.ModificationTime;
+		NewInfo.FileSize = StatData.FileSize;
+		NewInfo.Hash = CityHash64(reinterpret_cast<const char*>(Content.GetData()), Content.Num());
+		if (!SourcePath.EndsWith(TEXT(".js")))
+		{
+			continue;
+		}
+
+		FString Source;
+		FFileHelper::BufferToString(Source, Content.GetData(), Content.Num());
+		FRegexMatcher Matcher(RequirePattern, Source);
+		while (Matcher.FindNext())
+		{
+			FString RequiredPath = FPaths::Combine(FPaths::GetPath(SourcePath), Matcher.GetCaptureGroup(1));
+			FPaths::CollapseRelativeDirectories(RequiredPath);
+			for (const FString& Candidate : { RequiredPath, RequiredPath + TEXT(".js"), RequiredPath / TEXT("index.js") })
+			{
+				if (SourcePaths.Contains(Candidate))
+				{
+					NewInfo.Dependencies.AddUnique(Candidate);
+					break;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,18 @@
+#include "ReactorAtlasImage.h"
+#include "ImageAtlas.h"
+
+FSlateAtlasData UReactorAtlasImage::GetSlateAtlasData() const
+{
+	return FSlateAtlasData(AtlasTexture, StartUV, SizeUV);
+}
+
+void UReactorAtlasImage::BeginDestroy()
+{
+	if (PageIndex != INDEX_NONE)
+	{
+		FImageAtlas::Get().Release(PageIndex);
+		PageIndex = INDEX_NONE;
+	}
+
+	Super::BeginDestroy();
+}
@@ -107,8 +107,16 @@ void UReactorUIWidget::RunScriptToInitWidgetTree()
 		}
 		else
 		{
+			// every env is busy and the pool is full, try again once one has been released
 			UJsBridgeCaller::RemoveBridgeCaller(LaunchScriptPath);
-			UE_LOG(LogReactorUMG, Error, TEXT("Can not obtain any valid javascript runtime environment"))
+			UE_LOG(LogReactorUMG, Log, TEXT("All javascript runtime environments are busy, %s waits for a free one"), *LaunchScriptPath);
+			FJsEnvRuntime::GetInstance().WaitForFreeJsEnv([WeakThis = TWeakObjectPtr<UReactorUIWidget>(this)]()
+			{
+				if (WeakThis.IsValid())
+				{
+					WeakThis->RunScriptToInitWidgetTree();
+				}
+			});
 			return;
 		}
 		ReleaseJsEnv();
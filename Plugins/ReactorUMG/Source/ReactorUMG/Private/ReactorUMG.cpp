@@ -1,12 +1,35 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "ReactorUMG.h"
+#include "ReactorUMGSetting.h"
+#include "JsEnv.h"
+#include "UMGCommitBatch.h"
+#include "HAL/IConsoleManager.h"
 
 #define LOCTEXT_NAMESPACE "FReactorUMGModule"
 
 void FReactorUMGModule::StartupModule()
 {
 	// todo@Caleb196x: 生成types文件
+
+	if (IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Spine.ParallelWidgetUpdate")))
+	{
+		CVar->Set(GetDefault<UReactorUMGSetting>()->bParallelSpineUpdate, ECVF_SetByProjectSetting);
+	}
+
+	// called by the reconciler for every commit. Only leaf functions qualify: a fast call must not run script or
+	// allocate on the js heap, so nothing that can broadcast a delegate or run a widget override
+	// (SynchronizeWidgetProperties, SynchronizeSlotProperties) belongs here
+	const FName FastCallFunctionNames[] = {
+		GET_FUNCTION_NAME_CHECKED(UUMGCommitBatch, RegisterObject),
+	};
+	for (const FName& FunctionName : FastCallFunctionNames)
+	{
+		if (UFunction* Function = UUMGCommitBatch::StaticClass()->FindFunctionByName(FunctionName))
+		{
+			PUERTS_NAMESPACE::FJsEnv::AddFastCallFunction(Function);
+		}
+	}
 }
 
 void FReactorUMGModule::ShutdownModule()
@@ -1,6 +1,10 @@
 ﻿#include "ReactorUMGSetting.h"
 
 UReactorUMGSetting::UReactorUMGSetting()
-: TsScriptProjectDir(TEXT("TypeScript")), bAutoGenerateTSProject(true)
+: TsScriptProjectDir(TEXT("TypeScript")), bAutoGenerateTSProject(true), bUseJsStartupSnapshot(false),
+	MinWarmJsEnvs(1), MaxJsEnvs(4), JsEnvIdleEvictSeconds(60.f), bGenerateImageMips(true),
+	ImageTextureCacheBudgetMB(64), bCacheDownloadedImages(true),
+	bUseImageAtlas(false), MaxAtlasImageSize(64), ImageAtlasPageSize(1024),
+	bParallelSpineUpdate(false)
 {
 }
\ No newline at end of file
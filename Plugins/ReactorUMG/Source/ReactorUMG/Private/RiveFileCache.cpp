@@ -0,0 +1,295 @@
+#include "RiveFileCache.h"
+#include "IRiveRenderer.h"
+#include "IRiveRendererModule.h"
+#include "LogReactorUMG.h"
+#include "Rive/RiveFile.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Hash/CityHash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "rive/file_asset_loader.hpp"
+#include "rive/assets/file_asset.hpp"
+#include "rive/simple_array.hpp"
+THIRD_PARTY_INCLUDES_END
+
+namespace
+{
+uint64 HashRiveData(const TArray<uint8>& Data)
+{
+	return CityHash64(reinterpret_cast<const char*>(Data.GetData()), Data.Num());
+}
+}
+
+/**
+ * Reads the out of band assets of a file from its directory. Called on the importing thread, so unlike
+ * FRiveFileAssetLoader it creates no URiveAssets
+ */
+class FRiveFileCache::FAssetLoader final : public rive::FileAssetLoader
+{
+public:
+	explicit FAssetLoader(const FString& InDirectory)
+		: Directory(InDirectory)
+	{
+	}
+
+	virtual bool loadContents(rive::FileAsset& InAsset, rive::Span<const uint8> InBandBytes,
+		rive::Factory* InFactory) override
+	{
+		// in band assets are decoded by the importer
+		if (InBandBytes.size() > 0)
+		{
+			return false;
+		}
+
+		const FString AssetPath = FPaths::Combine(Directory, UTF8_TO_TCHAR(InAsset.uniqueFilename().c_str()));
+		TArray<uint8> Bytes;
+		if (!FFileHelper::LoadFileToArray(Bytes, *AssetPath))
+		{
+			UE_LOG(LogReactorUMG, Warning, TEXT("Unable to load the Rive asset '%s'"), *AssetPath);
+			return false;
+		}
+
+		rive::SimpleArray<uint8_t> Contents(Bytes.GetData(), Bytes.Num());
+		return InAsset.decode(Contents, InFactory);
+	}
+
+private:
+	FString Directory;
+};
+
+/**
+ * Everything prepared off the game thread, a native file not handed to a URiveFile is freed with it
+ */
+struct FRiveFileCache::FLoadResult
+{
+	explicit FLoadResult(const FString& FullPath)
+		: AssetLoader(FPaths::GetPath(FullPath))
+	{
+	}
+
+	FAssetLoader AssetLoader;
+	TArray<uint8> Data;
+	uint64 Hash = 0;
+	std::unique_ptr<rive::File> NativeFile;
+};
+
+FRiveFileCache& FRiveFileCache::Get()
+{
+	static FRiveFileCache Instance;
+	return Instance;
+}
+
+FString FRiveFileCache::MakeStatKey(const FString& FullPath)
+{
+	const FFileStatData StatData = IFileManager::Get().GetStatData(*FullPath);
+	if (!StatData.bIsValid || StatData.bIsDirectory)
+	{
+		return FString();
+	}
+
+	return LexToString(StatData.ModificationTime.GetTicks()) + TEXT("|") + LexToString(StatData.FileSize);
+}
+
+URiveFile* FRiveFileCache::FindCached(const FString& FullPath, const FString& StatKey) const
+{
+	const FEntry* Entry = Entries.Find(FullPath);
+	return Entry && Entry->StatKey == StatKey ? Entry->RiveFile.Get() : nullptr;
+}
+
+URiveFile* FRiveFileCache::Load(const FString& RivePath)
+{
+	check(IsInGameThread());
+	const FString FullPath = FPaths::ConvertRelativePathToFull(RivePath);
+	const FString StatKey = MakeStatKey(FullPath);
+	if (StatKey.IsEmpty())
+	{
+		UE_LOG(LogReactorUMG, Error, TEXT("Unable to import the Rive file '%s': the file does not exist"), *FullPath);
+		return nullptr;
+	}
+
+	if (URiveFile* CachedFile = FindCached(FullPath, StatKey))
+	{
+		return CachedFile;
+	}
+
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *FullPath))
+	{
+		UE_LOG(LogReactorUMG, Error, TEXT("Unable to import the Rive file '%s': Could not read the file"), *FullPath);
+		return nullptr;
+	}
+
+	const uint64 Hash = HashRiveData(Data);
+	return AddFile(FullPath, StatKey, Hash, MoveTemp(Data), nullptr);
+}
+
+void FRiveFileCache::LoadAsync(const FString& RivePath, FOnRiveFileLoaded OnLoaded)
+{
+	check(IsInGameThread());
+	const FString FullPath = FPaths::ConvertRelativePathToFull(RivePath);
+	const FString StatKey = MakeStatKey(FullPath);
+	if (StatKey.IsEmpty())
+	{
+		UE_LOG(LogReactorUMG, Error, TEXT("Unable to import the Rive file '%s': the file does not exist"), *FullPath);
+		OnLoaded(nullptr);
+		return;
+	}
+
+	if (URiveFile* CachedFile = FindCached(FullPath, StatKey))
+	{
+		OnLoaded(CachedFile);
+		return;
+	}
+
+	if (TArray<FOnRiveFileLoaded>* Pending = PendingLoads.Find(FullPath))
+	{
+		Pending->Add(MoveTemp(OnLoaded));
+		return;
+	}
+	PendingLoads.Add(FullPath).Add(MoveTemp(OnLoaded));
+
+	// a file touched without changing its content keeps its import
+	const FEntry* Entry = Entries.Find(FullPath);
+	const TOptional<uint64> CachedHash = Entry && Entry->RiveFile.IsValid() ? Entry->Hash : TOptional<uint64>();
+	IRiveRenderer* RiveRenderer = IRiveRendererModule::Get().GetRenderer();
+
+	Async(EAsyncExecution::TaskGraph, [this, FullPath, StatKey, CachedHash, RiveRenderer]()
+	{
+		TSharedPtr<FLoadResult> Result = MakeShared<FLoadResult>(FullPath);
+		if (!FFileHelper::LoadFileToArray(Result->Data, *FullPath))
+		{
+			UE_LOG(LogReactorUMG, Error, TEXT("Unable to import the Rive file '%s': Could not read the file"), *FullPath);
+			Result.Reset();
+		}
+		else
+		{
+			Result->Hash = HashRiveData(Result->Data);
+			if (!CachedHash.IsSet() || CachedHash.GetValue() != Result->Hash)
+			{
+				// null until the renderer is initialized, ImportAsync tries again then
+				Result->NativeFile = URiveFile::ImportNativeFile(RiveRenderer, Result->Data, &Result->AssetLoader);
+			}
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [this, FullPath, StatKey, Result = MoveTemp(Result)]()
+		{
+			if (!Result)
+			{
+				FinishLoad(FullPath, nullptr);
+			}
+			else if (URiveFile* CachedFile = FindCachedContent(FullPath, StatKey, Result->Hash))
+			{
+				FinishLoad(FullPath, CachedFile);
+			}
+			else if (Result->NativeFile)
+			{
+				FinishLoad(FullPath,
+					AddFile(FullPath, StatKey, Result->Hash, MoveTemp(Result->Data), MoveTemp(Result->NativeFile)));
+			}
+			else
+			{
+				// the renderer was not ready, or the cached file the import was skipped for has been collected since
+				ImportAsync(FullPath, StatKey, Result.ToSharedRef());
+			}
+		});
+	});
+}
+
+void FRiveFileCache::ImportAsync(const FString& FullPath, const FString& StatKey, TSharedRef<FLoadResult> Result)
+{
+	IRiveRenderer* RiveRenderer = IRiveRendererModule::Get().GetRenderer();
+	if (!RiveRenderer)
+	{
+		UE_LOG(LogReactorUMG, Error, TEXT("Failed to import the Rive file '%s': No Rive renderer"), *FullPath);
+		FinishLoad(FullPath, nullptr);
+		return;
+	}
+
+	RiveRenderer->CallOrRegister_OnInitialized(IRiveRenderer::FOnRendererInitialized::FDelegate::CreateLambda(
+		[this, FullPath, StatKey, Result](IRiveRenderer* InitializedRenderer)
+	{
+		Async(EAsyncExecution::TaskGraph, [this, FullPath, StatKey, Result, InitializedRenderer]()
+		{
+			Result->NativeFile = URiveFile::ImportNativeFile(InitializedRenderer, Result->Data, &Result->AssetLoader);
+
+			AsyncTask(ENamedThreads::GameThread, [this, FullPath, StatKey, Result]()
+			{
+				if (!Result->NativeFile)
+				{
+					UE_LOG(LogReactorUMG, Error, TEXT("Failed to import the Rive file '%s': Could not import the riv file"),
+						*FullPath);
+					FinishLoad(FullPath, nullptr);
+					return;
+				}
+
+				FinishLoad(FullPath,
+					AddFile(FullPath, StatKey, Result->Hash, MoveTemp(Result->Data), MoveTemp(Result->NativeFile)));
+			});
+		});
+	}));
+}
+
+void FRiveFileCache::FinishLoad(const FString& FullPath, URiveFile* RiveFile)
+{
+	TArray<FOnRiveFileLoaded> Callbacks;
+	PendingLoads.RemoveAndCopyValue(FullPath, Callbacks);
+	for (FOnRiveFileLoaded& Callback : Callbacks)
+	{
+		Callback(RiveFile);
+	}
+}
+
+URiveFile* FRiveFileCache::FindCachedContent(const FString& FullPath, const FString& StatKey, uint64 Hash)
+{
+	FEntry* Entry = Entries.Find(FullPath);
+	URiveFile* CachedFile = Entry && Entry->Hash == Hash ? Entry->RiveFile.Get() : nullptr;
+	if (CachedFile)
+	{
+		Entry->StatKey = StatKey;
+	}
+	return CachedFile;
+}
+
+URiveFile* FRiveFileCache::AddFile(const FString& FullPath, const FString& StatKey, uint64 Hash, TArray<uint8>&& Data,
+	std::unique_ptr<rive::File> NativeFile)
+{
+	RemoveStaleEntries();
+	if (URiveFile* CachedFile = FindCachedContent(FullPath, StatKey, Hash))
+	{
+		return CachedFile;
+	}
+
+	URiveFile* RiveFile = NewObject<URiveFile>(GetTransientPackage(), URiveFile::StaticClass(), NAME_None,
+		RF_Transient | RF_Public);
+	RiveFile->RuntimeImport(MoveTemp(Data), MoveTemp(NativeFile));
+
+	// still initializing if the renderer is not ready yet
+	if (RiveFile->InitializationState() == ERiveInitState::Uninitialized)
+	{
+		UE_LOG(LogReactorUMG, Error, TEXT("Failed to import the Rive file '%s': Could not import the riv file"),
+			*FullPath);
+		RiveFile->ConditionalBeginDestroy();
+		return nullptr;
+	}
+
+	FEntry& Entry = Entries.Add(FullPath);
+	Entry.StatKey = StatKey;
+	Entry.Hash = Hash;
+	Entry.RiveFile = RiveFile;
+	return RiveFile;
+}
+
+void FRiveFileCache::RemoveStaleEntries()
+{
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().RiveFile.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <memory>
+
+class URiveFile;
+
+namespace rive
+{
+class File;
+}
+
+/**
+ * Process wide cache of the Rive files loaded at runtime, every widget showing the same .riv shares one imported
+ * URiveFile instead of reading and importing it again.
+ * Files are keyed by absolute path and content hash: a file whose modification time or size changed is read again,
+ * but only imported again if its content changed.
+ * Async loads read, hash and import the file on the task graph, only the URiveFile is created on the game thread.
+ * Their out of band assets are loaded from the directory of the file.
+ * The cache only holds weak references: a file is released by the garbage collector once the last widget
+ * referencing it is gone. Concurrent async loads of the same file wait for one load.
+ * Game thread only.
+ */
+class FRiveFileCache
+{
+public:
+	/**
+	 * @param RiveFile nullptr on failure
+	 */
+	using FOnRiveFileLoaded = TFunction<void(URiveFile* RiveFile)>;
+
+	static FRiveFileCache& Get();
+
+	URiveFile* Load(const FString& RivePath);
+
+	/**
+	 * @param OnLoaded called synchronously if the file is cached already
+	 */
+	void LoadAsync(const FString& RivePath, FOnRiveFileLoaded OnLoaded);
+
+private:
+	struct FEntry
+	{
+		FString StatKey;
+		uint64 Hash = 0;
+		TWeakObjectPtr<URiveFile> RiveFile;
+	};
+
+	class FAssetLoader;
+
+	struct FLoadResult;
+
+	/**
+	 * @return empty if the file does not exist
+	 */
+	static FString MakeStatKey(const FString& FullPath);
+
+	/**
+	 * @return the cached file if its modification time and size did not change
+	 */
+	URiveFile* FindCached(const FString& FullPath, const FString& StatKey) const;
+
+	/**
+	 * @return the cached file if its content did not change, its stat key is updated
+	 */
+	URiveFile* FindCachedContent(const FString& FullPath, const FString& StatKey, uint64 Hash);
+
+	/**
+	 * Caches the file read from FullPath, an unchanged content keeps using the cached file
+	 * @param NativeFile imported on a worker thread, may be null
+	 */
+	URiveFile* AddFile(const FString& FullPath, const FString& StatKey, uint64 Hash, TArray<uint8>&& Data,
+		std::unique_ptr<rive::File> NativeFile);
+
+	/**
+	 * Imports a file read by LoadAsync on a worker once the renderer is ready
+	 */
+	void ImportAsync(const FString& FullPath, const FString& StatKey, TSharedRef<FLoadResult> Result);
+
+	void FinishLoad(const FString& FullPath, URiveFile* RiveFile);
+
+	void RemoveStaleEntries();
+
+	TMap<FString, FEntry> Entries;
+
+	TMap<FString, TArray<FOnRiveFileLoaded>> PendingLoads;
+};
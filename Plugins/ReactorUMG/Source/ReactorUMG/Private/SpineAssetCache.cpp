@@ -0,0 +1,181 @@
+#include "SpineAssetCache.h"
+#include "LogReactorUMG.h"
+#include "SpineAtlasAsset.h"
+#include "SpineSkeletonDataAsset.h"
+#include "HAL/FileManager.h"
+#include "Kismet/KismetRenderingLibrary.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+FSpineAssetCache& FSpineAssetCache::Get()
+{
+	static FSpineAssetCache Instance;
+	return Instance;
+}
+
+FString FSpineAssetCache::MakeKey(const FString& FilePath)
+{
+	const FString FullPath = FPaths::ConvertRelativePathToFull(FilePath);
+	const FFileStatData StatData = IFileManager::Get().GetStatData(*FullPath);
+	if (!StatData.bIsValid || StatData.bIsDirectory)
+	{
+		return FString();
+	}
+
+	return FullPath + TEXT("|") + LexToString(StatData.ModificationTime.GetTicks()) + TEXT("|") + LexToString(StatData.FileSize);
+}
+
+USpineAtlasAsset* FSpineAssetCache::LoadAtlas(const FString& AtlasPath)
+{
+	const FString Key = MakeKey(AtlasPath);
+	if (USpineAtlasAsset* CachedAtlas = Key.IsEmpty() ? nullptr : Atlases.FindRef(Key).Get())
+	{
+		return CachedAtlas;
+	}
+
+	FString RawData;
+	if (!FFileHelper::LoadFileToString(RawData, *AtlasPath))
+	{
+		UE_LOG(LogReactorUMG, Error, TEXT("Spine atlas asset file( %s ) not exists."), *AtlasPath);
+		return nullptr;
+	}
+
+	USpineAtlasAsset* SpineAtlasAsset = NewObject<USpineAtlasAsset>(GetTransientPackage(), USpineAtlasAsset::StaticClass(),
+		NAME_None, RF_Public|RF_Transient);
+	SpineAtlasAsset->SetRawData(RawData);
+#if WITH_EDITORONLY_DATA
+	SpineAtlasAsset->SetAtlasFileName(FName(*AtlasPath));
+#endif
+	const FString BaseFilePath = FPaths::GetPath(AtlasPath);
+
+	// load textures
+	spine::Atlas* Atlas = SpineAtlasAsset->GetAtlas();
+	SpineAtlasAsset->atlasPages.Empty();
+
+	spine::Vector<spine::AtlasPage*>& Pages = Atlas->getPages();
+	for (size_t i = 0; i < Pages.size(); ++i)
+	{
+		const FString SourceTextureFilename = FPaths::Combine(*BaseFilePath, UTF8_TO_TCHAR(Pages[i]->name.buffer()));
+		SpineAtlasAsset->atlasPages.Add(UKismetRenderingLibrary::ImportFileAsTexture2D(SpineAtlasAsset, SourceTextureFilename));
+	}
+
+	RemoveStaleEntries();
+	Atlases.Add(Key, SpineAtlasAsset);
+	return SpineAtlasAsset;
+}
+
+USpineSkeletonDataAsset* FSpineAssetCache::LoadSkeleton(const FString& SkeletonPath)
+{
+	const FString Key = MakeKey(SkeletonPath);
+	if (USpineSkeletonDataAsset* CachedSkeleton = Key.IsEmpty() ? nullptr : Skeletons.FindRef(Key).Get())
+	{
+		return CachedSkeleton;
+	}
+
+	TArray<uint8> RawData;
+	if (!FFileHelper::LoadFileToArray(RawData, *SkeletonPath, 0))
+	{
+		UE_LOG(LogReactorUMG, Error, TEXT("Spine skeleton asset file( %s ) not exists."), *SkeletonPath);
+		return nullptr;
+	}
+
+	USpineSkeletonDataAsset* SkeletonDataAsset = NewObject<USpineSkeletonDataAsset>(GetTransientPackage(),
+		USpineSkeletonDataAsset::StaticClass(), NAME_None, RF_Transient | RF_Public);
+#if WITH_EDITORONLY_DATA
+	SkeletonDataAsset->SetSkeletonDataFileName(FName(*SkeletonPath));
+	SkeletonDataAsset->SetRawData(RawData);
+#endif
+
+	RemoveStaleEntries();
+	Skeletons.Add(Key, SkeletonDataAsset);
+	return SkeletonDataAsset;
+}
+
+void FSpineAssetCache::LoadAsync(const FString& AtlasPath, const FString& SkeletonPath,
+	FSpineAssetLoader::FOnSpineAssetsLoaded OnLoaded)
+{
+	check(IsInGameThread());
+	const FString AtlasKey = MakeKey(AtlasPath);
+	if (AtlasKey.IsEmpty())
+	{
+		UE_LOG(LogReactorUMG, Error, TEXT("Spine atlas asset file( %s ) not exists."), *AtlasPath);
+		OnLoaded(nullptr, nullptr);
+		return;
+	}
+
+	FString SkeletonKey;
+	if (!SkeletonPath.IsEmpty())
+	{
+		SkeletonKey = MakeKey(SkeletonPath);
+		if (SkeletonKey.IsEmpty())
+		{
+			UE_LOG(LogReactorUMG, Error, TEXT("Spine skeleton asset file( %s ) not exists."), *SkeletonPath);
+			OnLoaded(nullptr, nullptr);
+			return;
+		}
+	}
+
+	USpineAtlasAsset* CachedAtlas = Atlases.FindRef(AtlasKey).Get();
+	USpineSkeletonDataAsset* CachedSkeleton = SkeletonKey.IsEmpty() ? nullptr : Skeletons.FindRef(SkeletonKey).Get();
+	if (CachedAtlas && (CachedSkeleton || SkeletonKey.IsEmpty()))
+	{
+		OnLoaded(CachedAtlas, CachedSkeleton);
+		return;
+	}
+
+	const FString PendingKey = AtlasKey + TEXT("||") + SkeletonKey;
+	if (TArray<FSpineAssetLoader::FOnSpineAssetsLoaded>* Pending = PendingLoads.Find(PendingKey))
+	{
+		Pending->Add(MoveTemp(OnLoaded));
+		return;
+	}
+	PendingLoads.Add(PendingKey).Add(MoveTemp(OnLoaded));
+
+	// a cached skeleton only needs its atlas, a cached atlas is reused to parse the skeleton
+	FSpineAssetLoader::LoadAsync(CachedAtlas, AtlasPath, CachedSkeleton ? FString() : SkeletonPath,
+		[this, PendingKey, AtlasKey, SkeletonKey, WeakCachedSkeleton = TWeakObjectPtr<USpineSkeletonDataAsset>(CachedSkeleton)](
+			USpineAtlasAsset* Atlas, USpineSkeletonDataAsset* SkeletonData)
+		{
+			RemoveStaleEntries();
+			if (Atlas)
+			{
+				Atlases.Add(AtlasKey, Atlas);
+			}
+
+			if (SkeletonData)
+			{
+				Skeletons.Add(SkeletonKey, SkeletonData);
+			}
+			else
+			{
+				SkeletonData = WeakCachedSkeleton.Get();
+			}
+
+			TArray<FSpineAssetLoader::FOnSpineAssetsLoaded> Callbacks;
+			PendingLoads.RemoveAndCopyValue(PendingKey, Callbacks);
+			for (FSpineAssetLoader::FOnSpineAssetsLoaded& Callback : Callbacks)
+			{
+				Callback(Atlas, SkeletonData);
+			}
+		});
+}
+
+void FSpineAssetCache::RemoveStaleEntries()
+{
+	for (auto It = Atlases.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	for (auto It = Skeletons.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpineAssetLoader.h"
+
+class USpineAtlasAsset;
+class USpineSkeletonDataAsset;
+
+/**
+ * Process wide cache of the Spine atlases (with their page textures) and skeleton data loaded at runtime,
+ * every widget showing the same files shares one asset instead of parsing and uploading them again.
+ * Files are keyed by absolute path, modification time and size, so an edited file is loaded again.
+ * The cache only holds weak references: an asset is released by the garbage collector once the last widget
+ * referencing it is gone. Concurrent async loads of the same files wait for one load.
+ * Game thread only.
+ */
+class FSpineAssetCache
+{
+public:
+	static FSpineAssetCache& Get();
+
+	USpineAtlasAsset* LoadAtlas(const FString& AtlasPath);
+
+	USpineSkeletonDataAsset* LoadSkeleton(const FString& SkeletonPath);
+
+	/**
+	 * @param OnLoaded called synchronously if every asset is cached already
+	 */
+	void LoadAsync(const FString& AtlasPath, const FString& SkeletonPath, FSpineAssetLoader::FOnSpineAssetsLoaded OnLoaded);
+
+private:
+	/**
+	 * @return empty if the file does not exist
+	 */
+	static FString MakeKey(const FString& FilePath);
+
+	void RemoveStaleEntries();
+
+	TMap<FString, TWeakObjectPtr<USpineAtlasAsset>> Atlases;
+
+	TMap<FString, TWeakObjectPtr<USpineSkeletonDataAsset>> Skeletons;
+
+	TMap<FString, TArray<FSpineAssetLoader::FOnSpineAssetsLoaded>> PendingLoads;
+};
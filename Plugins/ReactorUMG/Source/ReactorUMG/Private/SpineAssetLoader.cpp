@@ -0,0 +1,183 @@
+#include "SpineAssetLoader.h"
+#include "ImageTextureLoader.h"
+#include "LogReactorUMG.h"
+#include "SpineAtlasAsset.h"
+#include "SpineSkeletonDataAsset.h"
+#include "Async/Async.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace
+{
+/**
+ * Everything prepared off the game thread, native spine data not handed to an asset is freed with it
+ */
+struct FSpineLoadResult
+{
+	// kept alive while its atlas is used to parse the skeleton, only touched on the game thread
+	TStrongObjectPtr<USpineAtlasAsset> LoadedAtlas;
+	spine::Atlas* LoadedNativeAtlas = nullptr;
+
+	FString AtlasPath;
+	FString AtlasRawData;
+	spine::Atlas* Atlas = nullptr;
+	TArray<FDecodedImage> Pages;
+
+	FString SkeletonPath;
+	TArray<uint8> SkeletonRawData;
+	spine::SkeletonData* SkeletonData = nullptr;
+
+	~FSpineLoadResult()
+	{
+		delete SkeletonData;
+		delete Atlas;
+	}
+
+	bool Load(IImageWrapperModule& ImageWrapperModule, const FImageTextureLoader::FDecodeOptions& Options)
+	{
+		if (!LoadedNativeAtlas && !LoadAtlas(ImageWrapperModule, Options))
+		{
+			return false;
+		}
+
+		if (SkeletonPath.IsEmpty())
+		{
+			return true;
+		}
+
+		if (!FFileHelper::LoadFileToArray(SkeletonRawData, *SkeletonPath, 0))
+		{
+			UE_LOG(LogReactorUMG, Error, TEXT("Spine skeleton asset file( %s ) not exists."), *SkeletonPath);
+			return false;
+		}
+
+		const bool bIsJson = SkeletonPath.EndsWith(TEXT(".json"));
+		if (bIsJson && (SkeletonRawData.Num() == 0 || SkeletonRawData.Last() != 0))
+		{
+			SkeletonRawData.Add(0);
+		}
+
+		FString Error;
+		SkeletonData = USpineSkeletonDataAsset::ParseSkeletonData(SkeletonRawData, bIsJson,
+			LoadedNativeAtlas ? LoadedNativeAtlas : Atlas, Error);
+		if (!SkeletonData)
+		{
+			UE_LOG(LogReactorUMG, Error, TEXT("Couldn't load spine skeleton data( %s ): %s"), *SkeletonPath, *Error);
+			return false;
+		}
+		return true;
+	}
+
+	bool LoadAtlas(IImageWrapperModule& ImageWrapperModule, const FImageTextureLoader::FDecodeOptions& Options)
+	{
+		if (!FFileHelper::LoadFileToString(AtlasRawData, *AtlasPath))
+		{
+			UE_LOG(LogReactorUMG, Error, TEXT("Spine atlas asset file( %s ) not exists."), *AtlasPath);
+			return false;
+		}
+
+		Atlas = USpineAtlasAsset::ParseAtlas(AtlasRawData);
+		const FString BaseFilePath = FPaths::GetPath(AtlasPath);
+		spine::Vector<spine::AtlasPage*>& AtlasPages = Atlas->getPages();
+		Pages.SetNum(AtlasPages.size());
+		for (size_t i = 0; i < AtlasPages.size(); ++i)
+		{
+			const FString PageFilePath = FPaths::Combine(*BaseFilePath, UTF8_TO_TCHAR(AtlasPages[i]->name.buffer()));
+			if (!FImageTextureLoader::DecodeFile(ImageWrapperModule, PageFilePath, Options, Pages[i]))
+			{
+				// regions of a page without its texture would be drawn with whatever page comes next
+				UE_LOG(LogReactorUMG, Error, TEXT("Failed to load spine atlas page( %s )."), *PageFilePath);
+				return false;
+			}
+		}
+		return true;
+	}
+};
+}
+
+void FSpineAssetLoader::LoadAsync(USpineAtlasAsset* LoadedAtlas, const FString& AtlasPath, const FString& SkeletonPath,
+	FOnSpineAssetsLoaded OnLoaded)
+{
+	TSharedPtr<FSpineLoadResult> Result = MakeShared<FSpineLoadResult>();
+	Result->AtlasPath = AtlasPath;
+	Result->SkeletonPath = SkeletonPath;
+	if (LoadedAtlas)
+	{
+		Result->LoadedAtlas.Reset(LoadedAtlas);
+		Result->LoadedNativeAtlas = LoadedAtlas->GetAtlas();
+	}
+
+	IImageWrapperModule* ImageWrapperModule = &FImageTextureLoader::GetImageWrapperModule();
+	FImageTextureLoader::FDecodeOptions Options = FImageTextureLoader::GetDecodeOptions();
+	// atlas pages are already atlases, sharing the image atlas would break their uv
+	Options.MaxAtlasImageSize = 0;
+
+	Async(EAsyncExecution::TaskGraph, [Result, ImageWrapperModule, Options, OnLoaded = MoveTemp(OnLoaded)]() mutable
+	{
+		const bool bLoaded = Result->Load(*ImageWrapperModule, Options);
+		// the game thread has to hold the last reference, LoadedAtlas must not be released here
+		AsyncTask(ENamedThreads::GameThread, [Result = MoveTemp(Result), bLoaded, OnLoaded = MoveTemp(OnLoaded)]()
+		{
+			if (!bLoaded)
+			{
+				OnLoaded(nullptr, nullptr);
+				return;
+			}
+
+			USpineAtlasAsset* SpineAtlasAsset = Result->LoadedAtlas.Get();
+			spine::Atlas* Atlas = Result->LoadedNativeAtlas;
+			if (!SpineAtlasAsset)
+			{
+				SpineAtlasAsset = CreateAtlasAsset(Result->AtlasPath, Result->AtlasRawData, Result->Atlas, Result->Pages);
+				if (!SpineAtlasAsset)
+				{
+					OnLoaded(nullptr, nullptr);
+					return;
+				}
+				Atlas = Result->Atlas;
+				Result->Atlas = nullptr;
+			}
+
+			USpineSkeletonDataAsset* SkeletonDataAsset = nullptr;
+			if (Result->SkeletonData)
+			{
+				SkeletonDataAsset = NewObject<USpineSkeletonDataAsset>(GetTransientPackage(),
+					USpineSkeletonDataAsset::StaticClass(), NAME_None, RF_Transient | RF_Public);
+				SkeletonDataAsset->SetParsedSkeletonData(Result->SkeletonRawData, FName(*Result->SkeletonPath), Atlas,
+					Result->SkeletonData);
+				Result->SkeletonData = nullptr;
+			}
+
+			OnLoaded(SpineAtlasAsset, SkeletonDataAsset);
+		});
+	});
+}
+
+USpineAtlasAsset* FSpineAssetLoader::CreateAtlasAsset(const FString& AtlasPath, const FString& RawData, spine::Atlas* ParsedAtlas,
+	const TArray<FDecodedImage>& Pages)
+{
+	TArray<UTexture2D*> Textures;
+	Textures.Reserve(Pages.Num());
+	for (const FDecodedImage& Page : Pages)
+	{
+		UTexture2D* Texture = FImageTextureLoader::CreateTexture(Page);
+		if (!Texture)
+		{
+			UE_LOG(LogReactorUMG, Error, TEXT("Failed to create spine atlas page textures( %s )."), *AtlasPath);
+			return nullptr;
+		}
+		Textures.Add(Texture);
+	}
+
+	USpineAtlasAsset* SpineAtlasAsset = NewObject<USpineAtlasAsset>(GetTransientPackage(), USpineAtlasAsset::StaticClass(),
+		NAME_None, RF_Public|RF_Transient);
+	SpineAtlasAsset->SetParsedAtlas(RawData, ParsedAtlas);
+#if WITH_EDITORONLY_DATA
+	SpineAtlasAsset->SetAtlasFileName(FName(*AtlasPath));
+#endif
+
+	SpineAtlasAsset->atlasPages = MoveTemp(Textures);
+	return SpineAtlasAsset;
+}
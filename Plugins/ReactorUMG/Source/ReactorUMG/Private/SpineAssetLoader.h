@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USpineAtlasAsset;
+class USpineSkeletonDataAsset;
+struct FDecodedImage;
+
+namespace spine
+{
+class Atlas;
+}
+
+/**
+ * Loads a Spine atlas and its skeleton without stalling the game thread: the files are read, the atlas and
+ * skeleton are parsed and the atlas pages are decoded on the task graph, only the assets and page textures
+ * are created on the game thread.
+ * The assets are outered to the transient package, they are shared through FSpineAssetCache.
+ */
+class FSpineAssetLoader
+{
+public:
+	/**
+	 * @param OnLoaded called on the game thread, Atlas is nullptr on failure, SkeletonData is nullptr on failure
+	 * or if SkeletonPath is empty
+	 */
+	using FOnSpineAssetsLoaded = TFunction<void(USpineAtlasAsset* Atlas, USpineSkeletonDataAsset* SkeletonData)>;
+
+	/**
+	 * @param LoadedAtlas atlas of AtlasPath already loaded, the skeleton is parsed against it instead of loading the atlas again
+	 * @param AtlasPath absolute path of the .atlas file
+	 * @param SkeletonPath absolute path of the .json/.skel file, may be empty to only load the atlas
+	 */
+	static void LoadAsync(USpineAtlasAsset* LoadedAtlas, const FString& AtlasPath, const FString& SkeletonPath, FOnSpineAssetsLoaded OnLoaded);
+
+	/**
+	 * @return nullptr if a page texture couldn't be created, ParsedAtlas is still owned by the caller then
+	 */
+	static USpineAtlasAsset* CreateAtlasAsset(const FString& AtlasPath, const FString& RawData, spine::Atlas* ParsedAtlas,
+		const TArray<FDecodedImage>& Pages);
+};
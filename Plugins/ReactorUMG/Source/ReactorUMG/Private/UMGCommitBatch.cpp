@@ -0,0 +1,357 @@
+#include "UMGCommitBatch.h"
+
+#include "LogReactorUMG.h"
+#include "Components/PanelSlot.h"
+#include "Components/PanelWidget.h"
+#include "Components/Widget.h"
+#include "UObject/UnrealType.h"
+
+namespace
+{
+	class FCommandReader
+	{
+	public:
+		FCommandReader(const uint8* InData, int32 InLength) : Data(InData), Length(InLength), Offset(0) {}
+
+		bool IsEnd() const { return Offset >= Length; }
+
+		bool ReadUInt32(uint32& OutValue)
+		{
+			return Read(&OutValue, sizeof(uint32));
+		}
+
+		bool ReadInt32(int32& OutValue)
+		{
+			return Read(&OutValue, sizeof(int32));
+		}
+
+		bool ReadDouble(double& OutValue)
+		{
+			return Read(&OutValue, sizeof(double));
+		}
+
+		bool ReadString(FString& OutValue)
+		{
+			uint32 Len;
+			if (!ReadUInt32(Len))
+			{
+				return false;
+			}
+
+			const int32 Bytes = static_cast<int32>(Len) * sizeof(UTF16CHAR);
+			if (Bytes < 0 || Offset + Bytes > Length)
+			{
+				return false;
+			}
+
+			OutValue = FString(static_cast<int32>(Len), reinterpret_cast<const UTF16CHAR*>(Data + Offset));
+			Offset += Align(Bytes, 4);
+			return true;
+		}
+
+	private:
+		bool Read(void* Dest, int32 Size)
+		{
+			if (Offset + Size > Length)
+			{
+				return false;
+			}
+			// the JS side writes through a DataView, fields are not guaranteed to be naturally aligned
+			FMemory::Memcpy(Dest, Data + Offset, Size);
+			Offset += Size;
+			return true;
+		}
+
+		const uint8* Data;
+		int32 Length;
+		int32 Offset;
+	};
+
+	void SetNumberProperty(UObject* Object, FProperty* Property, double Value)
+	{
+		void* ValuePtr = Property->ContainerPtrToValuePtr<void>(Object);
+		if (FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+		{
+			BoolProperty->SetPropertyValue(ValuePtr, Value != 0);
+		}
+		else if (FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+		{
+			EnumProperty->GetUnderlyingProperty()->SetIntPropertyValue(ValuePtr, static_cast<int64>(Value));
+		}
+		else if (FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+		{
+			if (NumericProperty->IsFloatingPoint())
+			{
+				NumericProperty->SetFloatingPointPropertyValue(ValuePtr, Value);
+			}
+			else
+			{
+				NumericProperty->SetIntPropertyValue(ValuePtr, static_cast<int64>(Value));
+			}
+		}
+		else
+		{
+			UE_LOG(LogReactorUMG, Warning, TEXT("Commit batch: property %s of %s is not numeric"),
+				*Property->GetName(), *Object->GetName());
+		}
+	}
+
+	void SetStringProperty(UObject* Object, FProperty* Property, const FString& Value)
+	{
+		void* ValuePtr = Property->ContainerPtrToValuePtr<void>(Object);
+		if (FStrProperty* StrProperty = CastField<FStrProperty>(Property))
+		{
+			StrProperty->SetPropertyValue(ValuePtr, Value);
+		}
+		else if (FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+		{
+			TextProperty->SetPropertyValue(ValuePtr, FText::FromString(Value));
+		}
+		else if (FNameProperty* NameProperty = CastField<FNameProperty>(Property))
+		{
+			NameProperty->SetPropertyValue(ValuePtr, FName(*Value));
+		}
+		else
+		{
+			UE_LOG(LogReactorUMG, Warning, TEXT("Commit batch: property %s of %s is not a string"),
+				*Property->GetName(), *Object->GetName());
+		}
+	}
+
+	void SetObjectProperty(UObject* Object, FProperty* Property, UObject* Value)
+	{
+		FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property);
+		if (!ObjectProperty || (Value && !Value->IsA(ObjectProperty->PropertyClass)))
+		{
+			UE_LOG(LogReactorUMG, Warning, TEXT("Commit batch: can not assign %s to property %s of %s"),
+				Value ? *Value->GetName() : TEXT("null"), *Property->GetName(), *Object->GetName());
+			return;
+		}
+
+		ObjectProperty->SetObjectPropertyValue(ObjectProperty->ContainerPtrToValuePtr<void>(Object), Value);
+	}
+}
+
+int32 UUMGCommitBatch::RegisterObject(UObject* Object)
+{
+	check(IsInGameThread());
+	if (!Object)
+	{
+		return INDEX_NONE;
+	}
+
+	if (FreeHandles.Num() > 0)
+	{
+		const int32 Handle = FreeHandles.Pop();
+		Objects[Handle] = Object;
+		return Handle;
+	}
+
+	return Objects.Add(Object);
+}
+
+int32 UUMGCommitBatch::RegisterName(const FString& Name)
+{
+	check(IsInGameThread());
+	const FName PropertyName(*Name);
+	if (const int32* Id = NameIds.Find(PropertyName))
+	{
+		return *Id;
+	}
+
+	const int32 Id = Names.Add(PropertyName);
+	NameIds.Add(PropertyName, Id);
+	return Id;
+}
+
+void UUMGCommitBatch::ReleaseObject(int32 Handle)
+{
+	check(IsInGameThread());
+	if (Objects.IsValidIndex(Handle) && !Objects[Handle].IsExplicitlyNull())
+	{
+		Objects[Handle].Reset();
+		FreeHandles.Add(Handle);
+	}
+}
+
+UObject* UUMGCommitBatch::ResolveObject(int32 Handle) const
+{
+	return Objects.IsValidIndex(Handle) ? Objects[Handle].Get() : nullptr;
+}
+
+FProperty* UUMGCommitBatch::FindProperty(const UObject* Object, int32 NameId) const
+{
+	if (!Names.IsValidIndex(NameId))
+	{
+		return nullptr;
+	}
+
+	return FindFProperty<FProperty>(Object->GetClass(), Names[NameId]);
+}
+
+void UUMGCommitBatch::MarkDirty(UObject* Object, TArray<UObject*>& DirtyObjects, TSet<UObject*>& DirtySet)
+{
+	bool bAlreadyDirty = false;
+	DirtySet.Add(Object, &bAlreadyDirty);
+	if (!bAlreadyDirty)
+	{
+		DirtyObjects.Add(Object);
+	}
+}
+
+void UUMGCommitBatch::ApplyCommands(const FArrayBuffer& Commands)
+{
+	Apply(static_cast<const uint8*>(Commands.Data), static_cast<int32>(Commands.Length));
+}
+
+bool UUMGCommitBatch::Apply(const uint8* Data, int32 Length)
+{
+	check(IsInGameThread());
+	if (!Data || Length <= 0)
+	{
+		return true;
+	}
+
+	FCommandReader Reader(Data, Length);
+	TArray<UObject*> DirtyObjects;
+	TSet<UObject*> DirtySet;
+	bool bMalformed = false;
+
+	while (!Reader.IsEnd() && !bMalformed)
+	{
+		uint32 Op;
+		int32 Handle;
+		if (!Reader.ReadUInt32(Op) || !Reader.ReadInt32(Handle))
+		{
+			bMalformed = true;
+			break;
+		}
+
+		UObject* Target = ResolveObject(Handle);
+		switch (static_cast<EUMGCommitOp>(Op))
+		{
+		case EUMGCommitOp::SetBool:
+		case EUMGCommitOp::SetNumber:
+		case EUMGCommitOp::SetString:
+		case EUMGCommitOp::SetObject:
+		{
+			int32 NameId;
+			if (!Reader.ReadInt32(NameId))
+			{
+				bMalformed = true;
+				break;
+			}
+
+			// read the payload even if the target is gone so the stream stays in step
+			uint32 BoolValue = 0;
+			double NumberValue = 0;
+			FString StringValue;
+			int32 ValueHandle = INDEX_NONE;
+			const EUMGCommitOp SetOp = static_cast<EUMGCommitOp>(Op);
+			if ((SetOp == EUMGCommitOp::SetBool && !Reader.ReadUInt32(BoolValue))
+				|| (SetOp == EUMGCommitOp::SetNumber && !Reader.ReadDouble(NumberValue))
+				|| (SetOp == EUMGCommitOp::SetString && !Reader.ReadString(StringValue))
+				|| (SetOp == EUMGCommitOp::SetObject && !Reader.ReadInt32(ValueHandle)))
+			{
+				bMalformed = true;
+				break;
+			}
+
+			if (!Target)
+			{
+				break;
+			}
+
+			FProperty* Property = FindProperty(Target, NameId);
+			if (!Property)
+			{
+				UE_LOG(LogReactorUMG, Warning, TEXT("Commit batch: property %s not found in %s"),
+					Names.IsValidIndex(NameId) ? *Names[NameId].ToString() : TEXT("<invalid>"), *Target->GetClass()->GetName());
+				break;
+			}
+
+			if (SetOp == EUMGCommitOp::SetBool)
+			{
+				SetNumberProperty(Target, Property, BoolValue ? 1 : 0);
+			}
+			else if (SetOp == EUMGCommitOp::SetNumber)
+			{
+				SetNumberProperty(Target, Property, NumberValue);
+			}
+			else if (SetOp == EUMGCommitOp::SetString)
+			{
+				SetStringProperty(Target, Property, StringValue);
+			}
+			else
+			{
+				SetObjectProperty(Target, Property, ResolveObject(ValueHandle));
+			}
+			MarkDirty(Target, DirtyObjects, DirtySet);
+			break;
+		}
+		case EUMGCommitOp::AppendChild:
+		case EUMGCommitOp::RemoveChild:
+		{
+			int32 ChildHandle;
+			if (!Reader.ReadInt32(ChildHandle))
+			{
+				bMalformed = true;
+				break;
+			}
+
+			UPanelWidget* Parent = Cast<UPanelWidget>(Target);
+			UWidget* Child = Cast<UWidget>(ResolveObject(ChildHandle));
+			if (!Parent || !Child)
+			{
+				break;
+			}
+
+			if (static_cast<EUMGCommitOp>(Op) == EUMGCommitOp::AppendChild)
+			{
+				Parent->AddChild(Child);
+			}
+			else
+			{
+				Parent->RemoveChild(Child);
+			}
+			break;
+		}
+		case EUMGCommitOp::Sync:
+			if (Target)
+			{
+				MarkDirty(Target, DirtyObjects, DirtySet);
+			}
+			break;
+		case EUMGCommitOp::Release:
+			ReleaseObject(Handle);
+			break;
+		default:
+			bMalformed = true;
+			break;
+		}
+	}
+
+	if (bMalformed)
+	{
+		UE_LOG(LogReactorUMG, Error, TEXT("Commit batch: malformed command buffer (%d bytes), remaining commands dropped"), Length);
+	}
+
+	for (UObject* Object : DirtyObjects)
+	{
+		if (!IsValid(Object))
+		{
+			continue;
+		}
+
+		if (UWidget* Widget = Cast<UWidget>(Object))
+		{
+			Widget->SynchronizeProperties();
+		}
+		else if (UPanelSlot* Slot = Cast<UPanelSlot>(Object))
+		{
+			Slot->SynchronizeProperties();
+		}
+	}
+
+	return !bMalformed;
+}
@@ -1,18 +1,18 @@
 #include "UMGManager.h"
 
-#include "HttpModule.h"
 #include "Components/PanelSlot.h"
 #include "IRiveRendererModule.h"
 #include "LogReactorUMG.h"
 #include "ReactorUtils.h"
+#include "ImageTextureCache.h"
+#include "SpineAssetCache.h"
+#include "RiveFileCache.h"
 #include "Engine/Engine.h"
 #include "Async/Async.h"
 #include "Engine/AssetManager.h"
-#include "Kismet/KismetRenderingLibrary.h"
 #include "Rive/RiveFile.h"
 #include "Engine/Font.h"
 #include "Engine/StreamableManager.h"
-#include "Interfaces/IHttpResponse.h"
 #include "Blueprint/WidgetTree.h"
 #include "Blueprint/WidgetLayoutLibrary.h"
 #include "Components/Widget.h"
@@ -39,56 +39,39 @@ void UUMGManager::SynchronizeSlotProperties(UPanelSlot* Slot)
 
 USpineAtlasAsset* UUMGManager::LoadSpineAtlas(UObject* Context, const FString& AtlasPath, const FString& DirName)
 {
-    FString RawData;
-    const FString AssetFilePath = ProcessAssetFilePath(AtlasPath, DirName);
-    if (!FFileHelper::LoadFileToString(RawData, *AssetFilePath))
-    {
-        UE_LOG(LogReactorUMG, Error, TEXT("Spine atlas asset file( %s ) not exists."), *AssetFilePath);
-        return nullptr;
-    }
-    
-    USpineAtlasAsset* SpineAtlasAsset = NewObject<USpineAtlasAsset>(Context, USpineAtlasAsset::StaticClass(),
-        NAME_None, RF_Public|RF_Transient);
-    SpineAtlasAsset->SetRawData(RawData);
-#if WITH_EDITORONLY_DATA
-    SpineAtlasAsset->SetAtlasFileName(FName(*AssetFilePath));
-#endif
-    const FString BaseFilePath = FPaths::GetPath(AssetFilePath);
-
-    // load textures
-    spine::Atlas* Atlas = SpineAtlasAsset->GetAtlas();
-    SpineAtlasAsset->atlasPages.Empty();
-
-    spine::Vector<spine::AtlasPage*> &Pages = Atlas->getPages();
-    for (size_t i = 0; i < Pages.size(); ++i)
-    {
-        spine::AtlasPage *P = Pages[i];
-        const FString SourceTextureFilename = FPaths::Combine(*BaseFilePath, UTF8_TO_TCHAR(P->name.buffer()));
-        UTexture2D *texture = UKismetRenderingLibrary::ImportFileAsTexture2D(SpineAtlasAsset, SourceTextureFilename);
-        SpineAtlasAsset->atlasPages.Add(texture); 
-    }
-    
-    return SpineAtlasAsset;
+    return FSpineAssetCache::Get().LoadAtlas(ProcessAssetFilePath(AtlasPath, DirName));
 }
 
-USpineSkeletonDataAsset* UUMGManager::LoadSpineSkeleton(UObject* Context, const FString& SkeletonPath, const FString& DirName)
+void UUMGManager::LoadSpineAsync(UObject* Context, const FString& SkeletonPath, const FString& AtlasPath, const FString& DirName,
+    FSpineAssetsLoadedDelegate OnLoaded, FEasyDelegate OnFailed)
 {
-    TArray<uint8> RawData;
-    const FString AssetFilePath = ProcessAssetFilePath(SkeletonPath, DirName);
-    if (!FFileHelper::LoadFileToArray(RawData, *AssetFilePath, 0))
+    const FString SkeletonFilePath = SkeletonPath.IsEmpty() ? FString() : ProcessAssetFilePath(SkeletonPath, DirName);
+    const FString AtlasFilePath = !AtlasPath.IsEmpty() ? ProcessAssetFilePath(AtlasPath, DirName)
+        : FPaths::ChangeExtension(SkeletonFilePath, TEXT("atlas"));
+    if (AtlasFilePath.IsEmpty())
     {
-        UE_LOG(LogReactorUMG, Error, TEXT("Spine skeleton asset file( %s ) not exists."), *AssetFilePath);
-        return nullptr;
+        UE_LOG(LogReactorUMG, Error, TEXT("Neither a spine skeleton nor an atlas is given."));
+        OnFailed.ExecuteIfBound();
+        return;
     }
 
-    USpineSkeletonDataAsset* SkeletonDataAsset = NewObject<USpineSkeletonDataAsset>(Context,
-            USpineSkeletonDataAsset::StaticClass(), NAME_None, RF_Transient | RF_Public);
+    const bool bNeedSkeleton = !SkeletonFilePath.IsEmpty();
+    FSpineAssetCache::Get().LoadAsync(AtlasFilePath, SkeletonFilePath,
+        [bNeedSkeleton, OnLoaded, OnFailed](USpineAtlasAsset* Atlas, USpineSkeletonDataAsset* SkeletonData)
+        {
+            if (Atlas && (SkeletonData || !bNeedSkeleton))
+            {
+                OnLoaded.ExecuteIfBound(Atlas, SkeletonData);
+            } else
+            {
+                OnFailed.ExecuteIfBound();
+            }
+        });
+}
 
-#if WITH_EDITORONLY_DATA
-    SkeletonDataAsset->SetSkeletonDataFileName(FName(*AssetFilePath));
-    SkeletonDataAsset->SetRawData(RawData);
-#endif
-    return SkeletonDataAsset;
+USpineSkeletonDataAsset* UUMGManager::LoadSpineSkeleton(UObject* Context, const FString& SkeletonPath, const FString& DirName)
+{
+    return FSpineAssetCache::Get().LoadSkeleton(ProcessAssetFilePath(SkeletonPath, DirName));
 }
 
 URiveFile* UUMGManager::LoadRiveFile(UObject* Context, const FString& RivePath, const FString& DirName)
@@ -103,58 +86,31 @@ URiveFile* UUMGManager::LoadRiveFile(UObject* Context, const FString& RivePath,
         return nullptr;
     }
 
-    const FString RiveAssetFilePath = ProcessAssetFilePath(RivePath, DirName);
-    if (!FPaths::FileExists(RiveAssetFilePath))
-    {
-        UE_LOG(
-            LogReactorUMG,
-            Error,
-            TEXT(
-                "Unable to import the Rive file '%s': the file does not exist"),
-            *RiveAssetFilePath);
-        return nullptr;
-    }
+    return FRiveFileCache::Get().Load(ProcessAssetFilePath(RivePath, DirName));
+}
 
-    if (!Context)
+void UUMGManager::LoadRiveFileAsync(UObject* Context, const FString& RivePath, const FString& DirName,
+    FAssetLoadedDelegate OnLoaded, FEasyDelegate OnFailed)
+{
+    const FString RiveAssetFilePath = ProcessAssetFilePath(RivePath, DirName);
+    if (!IRiveRendererModule::Get().GetRenderer())
     {
-        UE_LOG(
-            LogReactorUMG,
-            Error,
-            TEXT(
-                "Unable to create the Rive file '%s': the context is null"),
+        UE_LOG(LogReactorUMG, Error, TEXT("Unable to import the Rive file '%s': the Renderer is null"),
             *RiveAssetFilePath);
-        return nullptr;
+        OnFailed.ExecuteIfBound();
+        return;
     }
 
-    TArray<uint8> FileBuffer;
-    if (!FFileHelper::LoadFileToArray(FileBuffer, *RiveAssetFilePath)) // load entire DNA file into the array
+    FRiveFileCache::Get().LoadAsync(RiveAssetFilePath, [OnLoaded, OnFailed](URiveFile* RiveFile)
     {
-        UE_LOG(
-            LogReactorUMG,
-            Error,
-            TEXT(
-                "Unable to import the Rive file '%s': Could not read the file"),
-            *RiveAssetFilePath);
-        return nullptr;
-    }
-    
-    URiveFile* RiveFile =
-    NewObject<URiveFile>(Context, URiveFile::StaticClass(), NAME_None, RF_Transient | RF_Public);
-    check(RiveFile);
-    
-#if WITH_EDITORONLY_DATA
-    if (!RiveFile->EditorImport(RiveAssetFilePath, FileBuffer))
-    {
-        UE_LOG(LogReactorUMG, Error,
-       TEXT("Failed to import the Rive file '%s': Could not import the "
-            "riv file"),
-        *RiveAssetFilePath);
-        RiveFile->ConditionalBeginDestroy();
-        return nullptr;
-    }
-#endif
-    
-    return RiveFile;
+        if (RiveFile)
+        {
+            OnLoaded.ExecuteIfBound(RiveFile);
+        } else
+        {
+            OnFailed.ExecuteIfBound();
+        }
+    });
 }
 
 UWorld* UUMGManager::GetCurrentWorld()
@@ -299,66 +255,31 @@ void UUMGManager::LoadImageBrushAsset(const FString& AssetPath, UObject* Context
 void UUMGManager::LoadImageTextureFromLocalFile(const FString& FilePath, UObject* Context,
     bool bIsSyncLoad, FAssetLoadedDelegate OnLoaded, FEasyDelegate OnFailed)
 {
-    if (bIsSyncLoad)
+    FImageTextureCache::Get().LoadFile(FilePath, Context, bIsSyncLoad, [OnLoaded, OnFailed](UObject* Resource)
     {
-        UTexture2D* Texture = UKismetRenderingLibrary::ImportFileAsTexture2D(nullptr, FilePath);
-        if (Texture)
-        {
-            Texture->AddToCluster(Context);
-            OnLoaded.ExecuteIfBound(Texture);
-        } else
-        {
-            OnFailed.ExecuteIfBound();
-        }
-    }else
+        OnImageTextureLoaded(Resource, OnLoaded, OnFailed);
+    });
+}
+
+void UUMGManager::OnImageTextureLoaded(UObject* Resource, FAssetLoadedDelegate OnLoaded, FEasyDelegate OnFailed)
+{
+    // the resource is shared by every widget showing the same image, it can not join the cluster of one of them
+    if (Resource)
     {
-        AsyncTask(ENamedThreads::GameThread, [FilePath, Context, OnLoaded, OnFailed]()
-        {
-            UTexture2D *Texture = UKismetRenderingLibrary::ImportFileAsTexture2D(nullptr, FilePath);
-            if (Texture)
-            {
-                Texture->AddToCluster(Context);
-                OnLoaded.ExecuteIfBound(Texture);
-            } else
-            {
-                OnFailed.ExecuteIfBound();
-            }
-        });
+        OnLoaded.ExecuteIfBound(Resource);
+    } else
+    {
+        OnFailed.ExecuteIfBound();
     }
 }
 
 void UUMGManager::LoadImageTextureFromURL(const FString& Url, UObject* Context,
     bool bIsSyncLoad, FAssetLoadedDelegate OnLoaded, FEasyDelegate OnFailed)
 {
-    FHttpModule& HTTP = FHttpModule::Get();
-    TSharedRef<IHttpRequest> HttpRequest = HTTP.CreateRequest();
-    HttpRequest->OnProcessRequestComplete().BindLambda(
-        [Url, Context, OnLoaded, OnFailed](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
-        {
-            check(IsInGameThread());
-            if (!bWasSuccessful || !Response.IsValid())
-            {
-                UE_LOG(LogTemp, Error, TEXT("Failed to download image."));
-                OnFailed.ExecuteIfBound();
-                return;
-            }
-
-            TArray<uint8> ImageData = Response->GetContent();
-            UTexture2D* Texture = UKismetRenderingLibrary::ImportBufferAsTexture2D(nullptr, ImageData);
-            if (Texture)
-            {
-                UE_LOG(LogReactorUMG, Log, TEXT("Download image file successfully for url: %s"), *Url);
-                Texture->AddToCluster(Context);
-                OnLoaded.ExecuteIfBound(Texture);
-            } else
-            {
-                OnFailed.ExecuteIfBound();
-            }
-        });
-    
-    HttpRequest->SetURL(Url);
-    HttpRequest->SetVerb("GET");
-    HttpRequest->ProcessRequest();
+    FImageTextureCache::Get().LoadUrl(Url, Context, [OnLoaded, OnFailed](UObject* Resource)
+    {
+        OnImageTextureLoaded(Resource, OnLoaded, OnFailed);
+    });
 }
 
 void UUMGManager::AddRootWidgetToWidgetTree(UWidgetTree* Container, UWidget* RootWidget)
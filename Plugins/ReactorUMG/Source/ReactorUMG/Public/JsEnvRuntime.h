@@ -1,6 +1,7 @@
 #pragma once
 #include "JsEnv.h"
 #include "JSLogger.h"
+#include "Containers/Ticker.h"
 
 class FReactorUMGJSLogger : public PUERTS_NAMESPACE::ILogger
 {
@@ -30,7 +31,16 @@ public:
 
 	~FJsEnvRuntime();
 
+	/**
+	 * Take an idle env out of the pool, a new one is created on demand while the pool is below its max size.
+	 * @return nullptr if all envs are busy and the pool is full, see WaitForFreeJsEnv
+	 */
 	REACTORUMG_API TSharedPtr<PUERTS_NAMESPACE::FJsEnv> GetFreeJsEnv();
+
+	/**
+	 * Call OnMaybeFree on a later frame once an env has been released, the callback should try GetFreeJsEnv again.
+	 */
+	REACTORUMG_API void WaitForFreeJsEnv(TFunction<void()> OnMaybeFree);
 		
 	REACTORUMG_API bool StartJavaScript(const TSharedPtr<PUERTS_NAMESPACE::FJsEnv>& JsEnv, const FString& Script, const TArray<TPair<FString, UObject*>>& Arguments) const;
 
@@ -41,14 +51,74 @@ public:
 	REACTORUMG_API void RebuildRuntimePool();
 
 	/**
-	 * reload all javascript files under ScriptHomeDir
+	 * reload the javascript files under ScriptHomeDir changed since the last restart of each env, together with the modules requiring them
 	 * @param ScriptHomeDir Relative path to the plugin content directory
 	 */
 	REACTORUMG_API void RestartJsScripts(const FString& JSContentDir, const FString& ScriptHomeDir, const FString& MainJsScript, const TArray<TPair<FString, UObject*>>& Arguments);
 
+	/**
+	 * Evaluate react and react-reconciler into V8 startup snapshots for the current platform, one per NODE_ENV, and
+	 * rebuild the pool from them. Must not be called while a script of the pool is running.
+	 */
+	REACTORUMG_API bool BuildStartupSnapshot(FString& OutError);
+
+	/**
+	 * @param NodeEnv "development" or "production"
+	 */
+	REACTORUMG_API static FString GetStartupSnapshotPath(const FString& NodeEnv);
+
+	/**
+	 * @return the NODE_ENV of the snapshot this build boots from, production in Shipping builds
+	 */
+	REACTORUMG_API static FString GetStartupSnapshotNodeEnv();
+
 private:
-	FJsEnvRuntime(int32 EnvPoolSize = 1);
-	TMap<TSharedPtr<PUERTS_NAMESPACE::FJsEnv>, int32> JsRuntimeEnvPool;
+	struct FPooledJsEnv
+	{
+		TSharedPtr<PUERTS_NAMESPACE::FJsEnv> JsEnv;
+		int32 DebugPortOffset;
+		double LastReleaseTime;
+		// whether a script has been started in this env
+		bool bUsed;
+		// content hash of every script file under the script home when RestartJsScripts last ran in this env
+		TMap<FString, uint64> ModuleHashes;
+	};
+
+	struct FScriptFileInfo
+	{
+		FDateTime TimeStamp;
+		int64 FileSize;
+		uint64 Hash;
+		// script files under the script home this file require()s with a relative path
+		TArray<FString> Dependencies;
+	};
+
+	FJsEnvRuntime();
+
+	FPooledJsEnv CreateJsEnv();
+
+	void LoadStartupSnapshot();
+
+	/**
+	 * Keeps MinWarmJsEnvs idle envs ready, evicts envs idle for too long and wakes up waiters
+	 */
+	bool Tick(float DeltaTime);
+
+	int32 NumJsEnvs() const { return IdleJsEnvs.Num() + BusyJsEnvs.Num(); }
+
+	/**
+	 * Rehash the script files whose time stamp or size changed and rescan their require() calls
+	 */
+	void UpdateScriptFileInfos(const TMap<FString, FString>& ModuleNames);
+
+	// stack, the most recently released env is handed out first
+	TArray<FPooledJsEnv> IdleJsEnvs;
+	TArray<FPooledJsEnv> BusyJsEnvs;
+	TArray<TFunction<void()>> Waiters;
+	TBitArray<> UsedDebugPortOffsets;
+	FTSTicker::FDelegateHandle TickerHandle;
+	// keyed by the source path of the file, shared by all envs
+	TMap<FString, FScriptFileInfo> ScriptFileInfos;
 	std::shared_ptr<FReactorUMGJSLogger> ReactorUmgLogger;
-	int32 EnvPoolSize;
+	std::shared_ptr<const TArray<uint8>> StartupSnapshot;
 };
@@ -0,0 +1,36 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/Texture2D.h"
+#include "Slate/SlateTextureAtlasInterface.h"
+#include "ReactorAtlasImage.generated.h"
+
+/**
+ * A small runtime loaded image packed into a shared atlas page, usable as brush resource object.
+ * Slate draws every image of the same page in one batch.
+ */
+UCLASS(Transient)
+class REACTORUMG_API UReactorAtlasImage : public UObject, public ISlateTextureAtlasInterface
+{
+	GENERATED_BODY()
+
+public:
+	virtual FSlateAtlasData GetSlateAtlasData() const override;
+
+	virtual void BeginDestroy() override;
+
+	UFUNCTION(BlueprintCallable, Category = "Widget|ReactorUMG")
+	FVector2D GetImageSize() const { return FVector2D(ImageSize); }
+
+	int64 GetMemorySize() const { return static_cast<int64>(ImageSize.X) * ImageSize.Y * 4; }
+
+	UPROPERTY()
+	TObjectPtr<UTexture2D> AtlasTexture;
+
+	FIntPoint ImageSize;
+
+	FVector2f StartUV;
+
+	FVector2f SizeUV;
+
+	int32 PageIndex = INDEX_NONE;
+};
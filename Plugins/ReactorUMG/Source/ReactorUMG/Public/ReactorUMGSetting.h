@@ -23,6 +23,73 @@ public:
 			"If the option is set, the system will automatically generate a TypeScript project. If not, you need to manually create a TS project, manually generate a type file, and set TsScriptProjectDir to a custom path."))
 	bool bAutoGenerateTSProject;
 
+	UPROPERTY(EditAnywhere, config,
+		Category = "ReactorUMG",
+		DisplayName = "Boot JavaScript environments from startup snapshot",
+		meta = (ToolTip =
+			"If the option is set and a startup snapshot has been built with the ReactorUMG.BuildJsSnapshot console command, react and react-reconciler are deserialized from it instead of being parsed and evaluated on every start. Shipping builds boot from the production snapshot, the others from the development one. Rebuild the snapshot after upgrading node_modules."))
+	bool bUseJsStartupSnapshot;
+
+	UPROPERTY(EditAnywhere, config,
+		Category = "ReactorUMG|Runtime Pool",
+		DisplayName = "Min warm JavaScript environments",
+		meta = (ClampMin = 0, ToolTip = "Number of idle JavaScript environments kept ready, spares are created one per frame."))
+	int32 MinWarmJsEnvs;
+
+	UPROPERTY(EditAnywhere, config,
+		Category = "ReactorUMG|Runtime Pool",
+		DisplayName = "Max JavaScript environments",
+		meta = (ClampMin = 1, ToolTip = "Upper bound of the pool, widgets initialized while all environments are busy wait for a free one."))
+	int32 MaxJsEnvs;
+
+	UPROPERTY(EditAnywhere, config,
+		Category = "ReactorUMG|Runtime Pool",
+		DisplayName = "Idle eviction seconds",
+		meta = (ClampMin = 0, ToolTip = "Spare environments that never ran a script are destroyed after being idle this long, 0 keeps them forever."))
+	float JsEnvIdleEvictSeconds;
+
+	UPROPERTY(EditAnywhere, config,
+		Category = "ReactorUMG|Image",
+		DisplayName = "Generate mips for image files",
+		meta = (ToolTip = "Build a mip chain for images loaded from files or urls so they stay sharp when drawn smaller than their size, costs a third more texture memory."))
+	bool bGenerateImageMips;
+
+	UPROPERTY(EditAnywhere, config,
+		Category = "ReactorUMG|Image",
+		DisplayName = "Image texture cache budget (MB)",
+		meta = (ClampMin = 0, ToolTip = "Textures of images no widget shows anymore are kept for reuse until the cache exceeds this size, least recently used first."))
+	int32 ImageTextureCacheBudgetMB;
+
+	UPROPERTY(EditAnywhere, config,
+		Category = "ReactorUMG|Image",
+		DisplayName = "Cache downloaded images on disk",
+		meta = (ToolTip = "Keep images loaded from urls under Saved/ReactorUMG/ImageCache and only download them again when their ETag changed."))
+	bool bCacheDownloadedImages;
+
+	UPROPERTY(EditAnywhere, config,
+		Category = "ReactorUMG|Image",
+		DisplayName = "Pack small images into atlas",
+		meta = (ToolTip = "Images loaded from files or urls that are not larger than the max atlas image size share atlas pages, so Slate can draw them in one batch."))
+	bool bUseImageAtlas;
+
+	UPROPERTY(EditAnywhere, config,
+		Category = "ReactorUMG|Image",
+		DisplayName = "Max atlas image size",
+		meta = (ClampMin = 1, EditCondition = "bUseImageAtlas", ToolTip = "Width and height limit of the images packed into the atlas, in pixels."))
+	int32 MaxAtlasImageSize;
+
+	UPROPERTY(EditAnywhere, config,
+		Category = "ReactorUMG|Image",
+		DisplayName = "Atlas page size",
+		meta = (ClampMin = 256, ClampMax = 4096, EditCondition = "bUseImageAtlas", ToolTip = "Width and height of one atlas page texture, rounded up to a power of two. Takes effect when the first page is created."))
+	int32 ImageAtlasPageSize;
+
+	UPROPERTY(EditAnywhere, config,
+		Category = "ReactorUMG|Spine",
+		DisplayName = "Update spine widgets in parallel",
+		meta = (ConfigRestartRequired = true, ToolTip = "Update the animations of all visible spine widgets as one parallel batch on worker threads before Slate ticks. Animation events are still broadcast on the game thread."))
+	bool bParallelSpineUpdate;
+
 	virtual FName GetCategoryName() const override
 	{
 		return FName(TEXT("ReactorUMG"));
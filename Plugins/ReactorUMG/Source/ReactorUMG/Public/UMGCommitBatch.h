@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UObject/WeakObjectPtr.h"
+#include "ArrayBuffer.h"
+#include "UMGCommitBatch.generated.h"
+
+class UWidget;
+class UPanelSlot;
+
+/**
+ * Opcodes of the packed commit command buffer produced by reactorUMG/misc/commit_batch.ts.
+ * Every field is a little-endian 32 bit word except SetNumber's value, which is a float64.
+ * Strings are encoded as a uint32 length followed by UTF-16 code units, padded to 4 bytes.
+ * Keep the numeric values in sync with CommitOp in commit_batch.ts.
+ */
+enum class EUMGCommitOp : uint32
+{
+	SetBool = 1,		// Handle, NameId, Value
+	SetNumber = 2,		// Handle, NameId, float64 Value
+	SetString = 3,		// Handle, NameId, String
+	SetObject = 4,		// Handle, NameId, ValueHandle (-1 for null)
+	AppendChild = 5,	// ParentHandle, ChildHandle
+	RemoveChild = 6,	// ParentHandle, ChildHandle
+	Sync = 7,			// Handle (widget or panel slot)
+	Release = 8,		// Handle
+};
+
+/**
+ * Decodes a command buffer built during a React commit and applies it to the UObjects it references.
+ * Objects and property names are registered once and referenced by integer handles afterwards,
+ * so a whole commit crosses the JS/C++ boundary a single time.
+ * Every js env creates its own batch (see reactorUMG/misc/commit_batch.ts), the handle tables are collected with it
+ * once the env is gone.
+ * Game thread only.
+ */
+UCLASS()
+class REACTORUMG_API UUMGCommitBatch : public UObject
+{
+	GENERATED_BODY()
+public:
+	/**
+	 * @return handle of the object, INDEX_NONE if Object is null
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Widget|ReactorUMG")
+	int32 RegisterObject(UObject* Object);
+
+	/**
+	 * @return the same id for the same name
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Widget|ReactorUMG")
+	int32 RegisterName(const FString& Name);
+
+	/**
+	 * Apply the commands recorded during a React commit, then synchronize every touched widget and slot exactly once.
+	 * @param Commands packed set-property / append-child / remove-child / sync / release commands
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Widget|ReactorUMG")
+	void ApplyCommands(const FArrayBuffer& Commands);
+
+	/**
+	 * @return false if the buffer is malformed, commands decoded before the error are still applied
+	 */
+	bool Apply(const uint8* Data, int32 Length);
+
+private:
+	void ReleaseObject(int32 Handle);
+
+	UObject* ResolveObject(int32 Handle) const;
+
+	FProperty* FindProperty(const UObject* Object, int32 NameId) const;
+
+	static void MarkDirty(UObject* Object, TArray<UObject*>& DirtyObjects, TSet<UObject*>& DirtySet);
+
+	TArray<TWeakObjectPtr<UObject>> Objects;
+
+	TArray<int32> FreeHandles;
+
+	TArray<FName> Names;
+
+	TMap<FName, int32> NameIds;
+};
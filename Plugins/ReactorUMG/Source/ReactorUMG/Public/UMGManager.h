@@ -16,10 +16,12 @@
 #include "SpineSkeletonDataAsset.h"
 #include "SpineAtlasAsset.h"
 #include "Rive/RiveDescriptor.h"
+#include "ArrayBuffer.h"
 #include "UMGManager.generated.h"
 
 DECLARE_DYNAMIC_DELEGATE(FEasyDelegate);
 DECLARE_DYNAMIC_DELEGATE_OneParam(FAssetLoadedDelegate, UObject*, Object);
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FSpineAssetsLoadedDelegate, USpineAtlasAsset*, Atlas, USpineSkeletonDataAsset*, SkeletonData);
 
 UCLASS(BlueprintType)
 class REACTORUMG_API UUMGManager : public UBlueprintFunctionLibrary
@@ -39,8 +41,9 @@ public:
     static void SynchronizeSlotProperties(UPanelSlot* Slot);
 
     /**
-     * TODO@Caleb196x: 需要对资源加载逻辑进行优化
-     * @param Context 
+     * The skeleton and atlas assets are shared by every caller loading the same unchanged file,
+     * they are released once no widget references them anymore
+     * @param Context unused, the shared assets live in the transient package
      * @param SkeletonPath 
      * @return 
      */
@@ -50,9 +53,31 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category="Widget|Spine")
 	static USpineAtlasAsset* LoadSpineAtlas(UObject* Context, const FString& AtlasPath, const FString& DirName);
 
+	/**
+	 * Read and parse the skeleton and atlas and decode the atlas pages on worker threads,
+	 * only the assets and page textures are created on the game thread.
+	 * Already loaded assets are shared, see LoadSpineSkeleton
+	 * @param SkeletonPath may be empty to only load the atlas
+	 * @param AtlasPath defaults to SkeletonPath with the .atlas extension
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Widget|Spine")
+	static void LoadSpineAsync(UObject* Context, const FString& SkeletonPath, const FString& AtlasPath, const FString& DirName,
+		FSpineAssetsLoadedDelegate OnLoaded, FEasyDelegate OnFailed);
+
+	/**
+	 * Already loaded files are shared between widgets
+	 */
 	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category="Widget|Rive")
 	static URiveFile* LoadRiveFile(UObject* Context, const FString& RivePath, const FString& DirName);
 
+	/**
+	 * Read and import the riv file on a worker thread, the URiveFile is created on the game thread.
+	 * Already loaded files are shared between widgets
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category="Widget|Rive")
+	static void LoadRiveFileAsync(UObject* Context, const FString& RivePath, const FString& DirName,
+		FAssetLoadedDelegate OnLoaded, FEasyDelegate OnFailed);
+
 	UFUNCTION(BlueprintCallable, Category="Widget|ReactorUMG")
 	static UWorld* GetCurrentWorld();
 
@@ -92,4 +117,5 @@ private:
 	static void LoadImageBrushAsset(const FString& AssetPath, UObject* Context, bool bIsSyncLoad, FAssetLoadedDelegate OnLoaded, FEasyDelegate OnFailed);
 	static void LoadImageTextureFromLocalFile(const FString& FilePath, UObject* Context, bool bIsSyncLoad, FAssetLoadedDelegate OnLoaded, FEasyDelegate OnFailed);
 	static void LoadImageTextureFromURL(const FString& Url, UObject* Context, bool bIsSyncLoad, FAssetLoadedDelegate OnLoaded, FEasyDelegate OnFailed);
+	static void OnImageTextureLoaded(UObject* Resource, FAssetLoadedDelegate OnLoaded, FEasyDelegate OnFailed);
 };
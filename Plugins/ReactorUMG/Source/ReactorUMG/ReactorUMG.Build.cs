@@ -47,6 +47,8 @@ public class ReactorUMG : ModuleRules
 				"SpinePlugin",
 				"Rive",
 				"HTTP",
+				"ImageWrapper",
+				"ImageCore",
 				"Json",
 				"JsonUtilities",
 				"JsonSerialization",
@@ -120,6 +120,24 @@ TUniquePtr<FAutoConsoleCommand> RegisterDebugGCConsoleCommand()
 		}));
 }
 
+TUniquePtr<FAutoConsoleCommand> RegisterBuildJsSnapshotConsoleCommand()
+{
+	return MakeUnique<FAutoConsoleCommand>(TEXT("ReactorUMG.BuildJsSnapshot"),
+		TEXT("Build the V8 startup snapshot with react and react-reconciler preloaded for the current platform"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			FString Error;
+			if (FJsEnvRuntime::GetInstance().BuildStartupSnapshot(Error))
+			{
+				UE_LOG(LogReactorUMG, Display, TEXT("Build startup snapshot finished~"));
+			}
+			else
+			{
+				UE_LOG(LogReactorUMG, Error, TEXT("Build startup snapshot failed: %s"), *Error);
+			}
+		}));
+}
+
 void CopyPredefinedTSProject()
 {
 	const FString PredefineDir = FPaths::Combine(FReactorUtils::GetPluginDir(), TEXT("Scripts"), TEXT("Project"));
@@ -237,6 +255,8 @@ void FReactorUMGEditorModule::StartupModule()
 	ConsoleCommand = RegisterConsoleCommand();
 
 	DebugGCConsoleCommand = RegisterDebugGCConsoleCommand();
+
+	BuildJsSnapshotConsoleCommand = RegisterBuildJsSnapshotConsoleCommand();
 	
 	const UReactorUMGSetting* PluginSettings = GetDefault<UReactorUMGSetting>();
 	if (PluginSettings->bAutoGenerateTSProject)
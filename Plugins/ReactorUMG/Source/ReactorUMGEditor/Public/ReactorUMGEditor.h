@@ -17,4 +17,6 @@ public:
     TUniquePtr<FAutoConsoleCommand> ConsoleCommand;
 
     TUniquePtr<FAutoConsoleCommand> DebugGCConsoleCommand;
+
+    TUniquePtr<FAutoConsoleCommand> BuildJsSnapshotConsoleCommand;
 };
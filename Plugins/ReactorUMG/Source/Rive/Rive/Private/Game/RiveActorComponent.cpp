@@ -288,6 +288,8 @@ URiveArtboard* URiveActorComponent::AddArtboard(
     }
 
     URiveArtboard* Artboard = NewObject<URiveArtboard>();
+    // every artboard is drawn again into the shared target each tick
+    Artboard->bSkipCleanRenders = false;
     Artboard->Initialize(InRiveFile,
                          RiveRenderTarget,
                          InArtboardName,
@@ -44,7 +44,14 @@ void URiveArtboard::AdvanceStateMachine(float InDeltaSeconds)
             {
                 PopulateReportedEvents();
             }
-            StateMachine->Advance(InDeltaSeconds);
+
+            // the frame the state machine settles on still has to be drawn
+            const bool bKeepGoing = StateMachine->Advance(InDeltaSeconds);
+            if (bKeepGoing || bIsAnimating)
+            {
+                MarkDirty();
+            }
+            bIsAnimating = bKeepGoing;
         }
     }
 
@@ -126,6 +133,7 @@ void URiveArtboard::Draw()
 
 void URiveArtboard::FireTrigger(const FString& InPropertyName) const
 {
+    MarkDirty();
     IRiveRenderer* RiveRenderer = IRiveRendererModule::Get().GetRenderer();
     if (ensure(RiveRenderer))
     {
@@ -140,6 +148,7 @@ void URiveArtboard::FireTrigger(const FString& InPropertyName) const
 void URiveArtboard::FireTriggerAtPath(const FString& InInputName,
                                       const FString& InPath) const
 {
+    MarkDirty();
     IRiveRenderer* RiveRenderer = IRiveRendererModule::Get().GetRenderer();
     if (ensure(RiveRenderer))
     {
@@ -362,6 +371,7 @@ FString URiveArtboard::GetTextValueAtPath(const FString& InInputName,
 
 void URiveArtboard::SetBoolValue(const FString& InPropertyName, bool bNewValue)
 {
+    MarkDirty();
     IRiveRenderer* RiveRenderer = IRiveRendererModule::Get().GetRenderer();
     if (ensure(RiveRenderer))
     {
@@ -378,6 +388,7 @@ void URiveArtboard::SetBoolValueAtPath(const FString& InInputName,
                                        const FString& InPath,
                                        bool& OutSuccess)
 {
+    MarkDirty();
     IRiveRenderer* RiveRenderer = IRiveRendererModule::Get().GetRenderer();
     if (ensure(RiveRenderer))
     {
@@ -425,6 +436,7 @@ void URiveArtboard::SetBoolValueAtPath(const FString& InInputName,
 void URiveArtboard::SetNumberValue(const FString& InPropertyName,
                                    float NewValue)
 {
+    MarkDirty();
     IRiveRenderer* RiveRenderer = IRiveRendererModule::Get().GetRenderer();
     if (ensure(RiveRenderer))
     {
@@ -441,6 +453,7 @@ void URiveArtboard::SetNumberValueAtPath(const FString& InInputName,
                                          const FString& InPath,
                                          bool& OutSuccess)
 {
+    MarkDirty();
     IRiveRenderer* RiveRenderer = IRiveRendererModule::Get().GetRenderer();
     if (ensure(RiveRenderer))
     {
@@ -488,6 +501,7 @@ void URiveArtboard::SetNumberValueAtPath(const FString& InInputName,
 void URiveArtboard::SetTextValue(const FString& InPropertyName,
                                  const FString& NewValue)
 {
+    MarkDirty();
     IRiveRenderer* RiveRenderer = IRiveRendererModule::Get().GetRenderer();
     if (ensure(RiveRenderer))
     {
@@ -509,6 +523,7 @@ void URiveArtboard::SetTextValueAtPath(const FString& InInputName,
                                        const FString& InPath,
                                        bool& OutSuccess)
 {
+    MarkDirty();
     IRiveRenderer* RiveRenderer = IRiveRendererModule::Get().GetRenderer();
     if (ensure(RiveRenderer))
     {
@@ -630,6 +645,7 @@ bool URiveArtboard::TriggerNamedRiveEvent(const FString& EventName,
 
 void URiveArtboard::PointerDown(const FVector2f& NewPosition)
 {
+    MarkDirty();
     FRiveStateMachine* StateMachine = GetStateMachine();
     if (StateMachine)
     {
@@ -639,6 +655,7 @@ void URiveArtboard::PointerDown(const FVector2f& NewPosition)
 
 void URiveArtboard::PointerUp(const FVector2f& NewPosition)
 {
+    MarkDirty();
     FRiveStateMachine* StateMachine = GetStateMachine();
     if (StateMachine)
     {
@@ -648,6 +665,7 @@ void URiveArtboard::PointerUp(const FVector2f& NewPosition)
 
 void URiveArtboard::PointerMove(const FVector2f& NewPosition)
 {
+    MarkDirty();
     FRiveStateMachine* StateMachine = GetStateMachine();
     if (StateMachine)
     {
@@ -657,6 +675,7 @@ void URiveArtboard::PointerMove(const FVector2f& NewPosition)
 
 void URiveArtboard::PointerExit(const FVector2f& NewPosition)
 {
+    MarkDirty();
     FRiveStateMachine* StateMachine = GetStateMachine();
     if (StateMachine)
     {
@@ -865,6 +884,7 @@ void URiveArtboard::SetStateMachineName(const FString& NewStateMachineName)
 {
     if (StateMachineName != NewStateMachineName)
     {
+        MarkDirty();
         StateMachineName = NewStateMachineName;
 
         StateMachinePtr = MakeUnique<FRiveStateMachine>(NativeArtboardPtr.get(),
@@ -917,7 +937,9 @@ void URiveArtboard::Tick_StateMachine(float InDeltaSeconds)
                                 STATGROUP_Rive);
     if (OnArtboardTick_StateMachine.IsBound())
     {
+        // nothing tells whether a custom tick changed the artboard
         OnArtboardTick_StateMachine.Execute(InDeltaSeconds, this);
+        MarkDirty();
     }
     else
     {
@@ -941,15 +963,22 @@ void URiveArtboard::Deinitialize()
     OnArtboardTick_StateMachine.Clear();
 }
 
-void URiveArtboard::Tick(float InDeltaSeconds)
+bool URiveArtboard::Tick(float InDeltaSeconds)
 {
     if (!RiveRenderTarget || !bIsInitialized)
     {
-        return;
+        return false;
     }
 
     Tick_StateMachine(InDeltaSeconds);
+    if (!bIsDirty && bSkipCleanRenders)
+    {
+        return false;
+    }
+
+    bIsDirty = false;
     Tick_Render(InDeltaSeconds);
+    return true;
 }
 
 rive::ArtboardInstance* URiveArtboard::GetNativeArtboard() const
@@ -1044,6 +1073,7 @@ FVector2f URiveArtboard::GetSize() const
 
 void URiveArtboard::SetSize(FVector2f InVector)
 {
+    MarkDirty();
     IRiveRenderer* RiveRenderer = IRiveRendererModule::Get().GetRenderer();
     if (!RiveRenderer)
     {
@@ -1178,12 +1208,15 @@ void URiveArtboard::Initialize_Internal(const rive::Artboard* InNativeArtboard)
         //UE_LOG(LogRive, Log, TEXT("Event: %hs"), Event->name().c_str());
     }
 
+    bIsAnimating = false;
+    MarkDirty();
     bIsInitialized = true;
 }
 
 void URiveArtboard::SetViewModelInstance(
     URiveViewModelInstance* RiveViewModelInstance)
 {
+    MarkDirty();
     // Store off the VM instance because we need to set
     // it on dynamically created state machines.
     CurrentViewModelInstance = RiveViewModelInstance;
@@ -174,28 +174,7 @@ void URiveFile::Initialize()
                         return;
                     }
 
-                    // UI Helpers
-                    for (int i = 0; i < RiveNativeFilePtr->artboardCount(); ++i)
-                    {
-                        auto Artboard = NewObject<URiveArtboard>();
-
-                        // We won't tick the artboard, it's just
-                        // initialized for informational purposes.
-                        Artboard->Initialize(this, nullptr, i, "");
-                        Artboards.Add(Artboard);
-                        ArtboardNames.Add(Artboard->GetArtboardName());
-                    }
-
-                    for (int i = 0; i < RiveNativeFilePtr->viewModelCount();
-                         ++i)
-                    {
-                        auto ViewModel = NewObject<URiveViewModel>();
-                        ViewModel->Initialize(
-                            RiveNativeFilePtr->viewModelByIndex(i));
-                        ViewModels.Add(ViewModel);
-                    }
-
-                    BroadcastInitializationResult(true);
+                    OnNativeFileImported();
                     return;
                 }
 
@@ -205,6 +184,101 @@ void URiveFile::Initialize()
 #endif // WITH_RIVE
 }
 
+#if WITH_RIVE
+void URiveFile::RuntimeImport(TArray<uint8>&& InRiveFileData,
+                              std::unique_ptr<rive::File> InNativeFile)
+{
+    check(IsInGameThread());
+
+    // the native file was imported from this buffer, moving the array keeps
+    // its allocation
+    RiveFileData = MoveTemp(InRiveFileData);
+    RiveNativeFileSpan = {};
+    bNeedsImport = false;
+
+    IRiveRenderer* RiveRenderer = IRiveRendererModule::IsAvailable()
+                                      ? IRiveRendererModule::Get().GetRenderer()
+                                      : nullptr;
+    if (!InNativeFile || !RiveRenderer)
+    {
+        InitState = ERiveInitState::Uninitialized;
+        Initialize();
+        return;
+    }
+
+    WasLastInitializationSuccessful.Reset();
+    InitState = ERiveInitState::Initializing;
+    OnStartInitializingDelegate.Broadcast();
+
+    RiveNativeFileSpan =
+        rive::make_span(RiveFileData.GetData(), RiveFileData.Num());
+
+    FScopeLock Lock(&RiveRenderer->GetThreadDataCS());
+    ArtboardNames.Empty();
+    Artboards.Empty();
+    ViewModels.Empty();
+    RiveNativeFilePtr = MoveTemp(InNativeFile);
+    OnNativeFileImported();
+}
+
+std::unique_ptr<rive::File> URiveFile::ImportNativeFile(
+    IRiveRenderer* InRiveRenderer,
+    const TArray<uint8>& InRiveFileData,
+    rive::FileAssetLoader* InAssetLoader)
+{
+    if (!InRiveRenderer || InRiveFileData.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    FScopeLock Lock(&InRiveRenderer->GetThreadDataCS());
+    rive::gpu::RenderContext* RenderContext =
+        InRiveRenderer->GetRenderContext();
+    if (!RenderContext)
+    {
+        return nullptr;
+    }
+
+    // not FRiveFileAssetLoader: it would create URiveAssets, the renderer
+    // decodes the in band assets itself
+    rive::ImportResult ImportResult;
+    std::unique_ptr<rive::File> NativeFile = rive::File::import(
+        rive::make_span(InRiveFileData.GetData(), InRiveFileData.Num()),
+        RenderContext,
+        &ImportResult,
+        InAssetLoader);
+    if (ImportResult != rive::ImportResult::success)
+    {
+        return nullptr;
+    }
+    return NativeFile;
+}
+
+void URiveFile::OnNativeFileImported()
+{
+    // UI Helpers
+    for (int i = 0; i < RiveNativeFilePtr->artboardCount(); ++i)
+    {
+        auto Artboard = NewObject<URiveArtboard>();
+
+        // We won't tick the artboard, it's just
+        // initialized for informational purposes.
+        Artboard->Initialize(this, nullptr, i, "");
+        Artboards.Add(Artboard);
+        ArtboardNames.Add(Artboard->GetArtboardName());
+    }
+
+    for (int i = 0; i < RiveNativeFilePtr->viewModelCount(); ++i)
+    {
+        auto ViewModel = NewObject<URiveViewModel>();
+        ViewModel->Initialize(RiveNativeFilePtr->viewModelByIndex(i));
+        ViewModels.Add(ViewModel);
+    }
+
+    BroadcastInitializationResult(true);
+}
+#endif // WITH_RIVE
+
 void URiveFile::BroadcastInitializationResult(bool bSuccess)
 {
     WasLastInitializationSuccessful = bSuccess;
@@ -0,0 +1,70 @@
+// Copyright Rive, Inc. All rights reserved.
+
+#include "Rive/RiveScheduler.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+
+namespace
+{
+// steps made up for at most after a hitch, the rest is dropped
+constexpr int64 MaxCatchUpSteps = 4;
+
+TAutoConsoleVariable<float> CVarRiveMaxUpdateRate(
+    TEXT("Rive.MaxUpdateRate"),
+    0.f,
+    TEXT("Caps how many times per second every rive texture object advances "
+         "and renders its artboard, 0 for no cap."),
+    ECVF_Default);
+} // namespace
+
+FRiveScheduler& FRiveScheduler::Get()
+{
+    static FRiveScheduler Instance;
+    return Instance;
+}
+
+void FRiveScheduler::Tick()
+{
+    if (LastTickedFrame == GFrameCounter)
+    {
+        return;
+    }
+
+    LastTickedFrame = GFrameCounter;
+    Time += FApp::GetDeltaTime();
+}
+
+bool FRiveScheduler::ShouldStep(float InRate,
+                                int64& InOutStep,
+                                float& InOutDeltaSeconds) const
+{
+    const float MaxRate = CVarRiveMaxUpdateRate.GetValueOnGameThread();
+    float Rate = InRate;
+    if (MaxRate > 0.f && (Rate <= 0.f || Rate > MaxRate))
+    {
+        Rate = MaxRate;
+    }
+
+    if (Rate <= 0.f)
+    {
+        return true;
+    }
+
+    const int64 Step = FMath::FloorToInt64(Time * Rate);
+    if (InOutStep == INDEX_NONE)
+    {
+        InOutStep = Step;
+        return true;
+    }
+
+    if (Step <= InOutStep)
+    {
+        return false;
+    }
+
+    InOutDeltaSeconds =
+        static_cast<float>(FMath::Min(Step - InOutStep, MaxCatchUpSteps)) /
+        Rate;
+    InOutStep = Step;
+    return true;
+}
@@ -0,0 +1,39 @@
+// Copyright Rive, Inc. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Shared clock of the texture objects updating at a max rate. Every texture
+ * object with the same rate steps on the same frames and by whole fixed
+ * steps, so their artboards render together (and a shared atlas page is
+ * redrawn once per step) instead of spreading over every frame.
+ * Rive.MaxUpdateRate caps the rate of every texture object. Game thread only.
+ */
+class FRiveScheduler
+{
+public:
+    static FRiveScheduler& Get();
+
+    /**
+     * Advances the clock, only the first call of an engine frame counts
+     */
+    void Tick();
+
+    /**
+     * @param InRate updates per second, 0 to update every frame
+     * @param InOutStep the step the caller last updated at, INDEX_NONE before
+     * the first update
+     * @param InOutDeltaSeconds set to the length of the steps to advance by
+     * @return false if the caller skips this frame
+     */
+    bool ShouldStep(float InRate,
+                    int64& InOutStep,
+                    float& InOutDeltaSeconds) const;
+
+private:
+    double Time = 0.0;
+
+    uint64 LastTickedFrame = 0;
+};
@@ -0,0 +1,495 @@
+// Copyright Rive, Inc. All rights reserved.
+
+#include "Rive/RiveTextureAtlas.h"
+#include "IRiveRenderer.h"
+#include "IRiveRendererModule.h"
+#include "Logs/RiveLog.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Rive/RiveTexture.h"
+#include "RiveRendererSettings.h"
+#include "RiveTypes.h"
+#include "UObject/Package.h"
+
+namespace
+{
+// keeps bilinear sampling of a cell from bleeding into its neighbours
+constexpr int32 AtlasPadding = 1;
+} // namespace
+
+#if WITH_RIVE
+void FRiveAtlasRenderTarget::Submit()
+{
+    SubmittedCommands = RenderCommands;
+    FRiveTextureAtlas::Get().MarkDirty(*this);
+}
+
+void FRiveAtlasRenderTarget::SubmitAndClear()
+{
+    SubmittedCommands = MoveTemp(RenderCommands);
+    RenderCommands.Reset();
+    FRiveTextureAtlas::Get().MarkDirty(*this);
+}
+
+void FRiveAtlasRenderTarget::Save()
+{
+    RenderCommands.Push(FRiveRenderCommand(ERiveRenderCommandType::Save));
+}
+
+void FRiveAtlasRenderTarget::Restore()
+{
+    RenderCommands.Push(FRiveRenderCommand(ERiveRenderCommandType::Restore));
+}
+
+void FRiveAtlasRenderTarget::Transform(float X1,
+                                       float Y1,
+                                       float X2,
+                                       float Y2,
+                                       float TX,
+                                       float TY)
+{
+    FRiveRenderCommand RenderCommand(ERiveRenderCommandType::Transform);
+    RenderCommand.X = X1;
+    RenderCommand.Y = Y1;
+    RenderCommand.X2 = X2;
+    RenderCommand.Y2 = Y2;
+    RenderCommand.TX = TX;
+    RenderCommand.TY = TY;
+    RenderCommands.Push(RenderCommand);
+}
+
+void FRiveAtlasRenderTarget::Translate(const FVector2f& InVector)
+{
+    FRiveRenderCommand RenderCommand(ERiveRenderCommandType::Translate);
+    RenderCommand.TX = InVector.X;
+    RenderCommand.TY = InVector.Y;
+    RenderCommands.Push(RenderCommand);
+}
+
+void FRiveAtlasRenderTarget::Draw(rive::Artboard* InArtboard)
+{
+    FRiveRenderCommand RenderCommand(ERiveRenderCommandType::DrawArtboard);
+    RenderCommand.NativeArtboard = InArtboard;
+    RenderCommands.Push(RenderCommand);
+}
+
+void FRiveAtlasRenderTarget::Align(const FBox2f& InBox,
+                                   ERiveFitType InFit,
+                                   const FVector2f& InAlignment,
+                                   float InScaleFactor,
+                                   rive::Artboard* InArtboard)
+{
+    FRiveRenderCommand RenderCommand(ERiveRenderCommandType::AlignArtboard);
+    RenderCommand.FitType = InFit;
+    RenderCommand.X = InAlignment.X;
+    RenderCommand.Y = InAlignment.Y;
+    RenderCommand.ScaleFactor =
+        InFit == ERiveFitType::Layout ? InScaleFactor : 1.f;
+    RenderCommand.TX = InBox.Min.X;
+    RenderCommand.TY = InBox.Min.Y;
+    RenderCommand.X2 = InBox.Max.X;
+    RenderCommand.Y2 = InBox.Max.Y;
+    RenderCommand.NativeArtboard = InArtboard;
+    RenderCommands.Push(RenderCommand);
+}
+
+void FRiveAtlasRenderTarget::Align(ERiveFitType InFit,
+                                   const FVector2f& InAlignment,
+                                   float InScaleFactor,
+                                   rive::Artboard* InArtboard)
+{
+    Align(FBox2f(FVector2f{0.f, 0.f}, FVector2f(GetWidth(), GetHeight())),
+          InFit,
+          InAlignment,
+          InScaleFactor,
+          InArtboard);
+}
+
+FMatrix FRiveAtlasRenderTarget::GetTransformMatrix() const
+{
+    // in cell space, input is mapped against the size of the cell
+    TArray<FMatrix> SavedMatrices;
+    FMatrix CurrentMatrix = FMatrix::Identity;
+
+    for (const FRiveRenderCommand& RenderCommand : RenderCommands)
+    {
+        switch (RenderCommand.Type)
+        {
+            case ERiveRenderCommandType::Save:
+                SavedMatrices.Add(CurrentMatrix);
+                break;
+            case ERiveRenderCommandType::Restore:
+                CurrentMatrix = SavedMatrices.IsEmpty() ? FMatrix::Identity
+                                                        : SavedMatrices.Pop();
+                break;
+            case ERiveRenderCommandType::AlignArtboard:
+            case ERiveRenderCommandType::Transform:
+            case ERiveRenderCommandType::Translate:
+                CurrentMatrix =
+                    RenderCommand.GetSavedTransform() * CurrentMatrix;
+                break;
+            default:
+                break;
+        }
+    }
+    return CurrentMatrix;
+}
+
+void FRiveAtlasRenderTarget::RegisterRenderCommand(
+    RiveRenderFunction RenderFunction)
+{
+    UE_LOG(LogRive,
+           Warning,
+           TEXT("Custom render commands are not supported by atlas render "
+                "targets, disable the texture atlas to use them."));
+}
+#endif // WITH_RIVE
+
+URiveTexture* FRiveAtlasRenderTarget::GetTexture() const
+{
+    return FRiveTextureAtlas::Get().GetPageTexture(PageIndex);
+}
+
+FBox2f FRiveAtlasRenderTarget::GetUVRegion() const
+{
+    const float PageSize = FRiveTextureAtlas::Get().GetPageSize();
+    if (!HasCell() || PageSize <= 0.f)
+    {
+        return FBox2f(FVector2f::ZeroVector, FVector2f::UnitVector);
+    }
+
+    return FBox2f(FVector2f(CellPosition) / PageSize,
+                  FVector2f(CellPosition + CellSize) / PageSize);
+}
+
+FRiveTextureAtlas& FRiveTextureAtlas::Get()
+{
+    static FRiveTextureAtlas Instance;
+    return Instance;
+}
+
+int32 FRiveTextureAtlas::GetMaxImageSize() const
+{
+    const URiveRendererSettings* Settings = GetDefault<URiveRendererSettings>();
+    const int32 CurrentPageSize =
+        Pages.Num() > 0 ? PageSize : Settings->TextureAtlasPageSize;
+    return FMath::Clamp(Settings->MaxTextureAtlasImageSize,
+                        0,
+                        CurrentPageSize - 2 * AtlasPadding);
+}
+
+TSharedRef<FRiveAtlasRenderTarget> FRiveTextureAtlas::CreateRenderTarget()
+{
+    return MakeShared<FRiveAtlasRenderTarget>();
+}
+
+bool FRiveTextureAtlas::Resize(FRiveAtlasRenderTarget& InTarget,
+                               const FIntPoint& InSize)
+{
+    check(IsInGameThread());
+    const FIntPoint Size = InSize.ComponentMax(FIntPoint(1, 1));
+    if (InTarget.HasCell() && InTarget.CellSize == Size)
+    {
+        return true;
+    }
+
+    Release(InTarget);
+
+    const int32 MaxImageSize = GetMaxImageSize();
+    if (Size.X > MaxImageSize || Size.Y > MaxImageSize)
+    {
+        return false;
+    }
+
+    FCell Cell;
+    int32 PageIndex = INDEX_NONE;
+    for (int32 Index = 0; Index < Pages.Num(); ++Index)
+    {
+        if (Allocate(Pages[Index], Size, Cell))
+        {
+            PageIndex = Index;
+            break;
+        }
+    }
+
+    if (PageIndex == INDEX_NONE)
+    {
+        PageIndex = AddPage();
+        if (PageIndex == INDEX_NONE || !Allocate(Pages[PageIndex], Size, Cell))
+        {
+            return false;
+        }
+    }
+
+    FPage& Page = Pages[PageIndex];
+    FEntry& Entry = Page.Entries.AddDefaulted_GetRef();
+    Entry.Target = StaticCastSharedRef<FRiveAtlasRenderTarget>(
+        InTarget.AsShared());
+    Entry.Cell = Cell;
+    Page.bDirty = true;
+
+    InTarget.PageIndex = PageIndex;
+    InTarget.CellPosition = Cell.Position + FIntPoint(AtlasPadding);
+    InTarget.CellSize = Size;
+    return true;
+}
+
+void FRiveTextureAtlas::Release(FRiveAtlasRenderTarget& InTarget)
+{
+    if (!Pages.IsValidIndex(InTarget.PageIndex))
+    {
+        InTarget.PageIndex = INDEX_NONE;
+        return;
+    }
+
+    FPage& Page = Pages[InTarget.PageIndex];
+    const int32 EntryIndex =
+        Page.Entries.IndexOfByPredicate([&InTarget](const FEntry& Entry) {
+            return Entry.Target.Pin().Get() == &InTarget;
+        });
+    if (EntryIndex != INDEX_NONE)
+    {
+        Page.FreeCells.Add(Page.Entries[EntryIndex].Cell);
+        Page.Entries.RemoveAtSwap(EntryIndex);
+    }
+
+    if (Page.Entries.Num() == 0)
+    {
+        // nothing samples the page anymore, it is packed again from scratch
+        Page.Shelves.Reset();
+        Page.FreeCells.Reset();
+        Page.UsedHeight = 0;
+    }
+
+    // the cell has to be cleared so it does not show up in a newer cell
+    Page.bDirty = true;
+    InTarget.PageIndex = INDEX_NONE;
+    InTarget.SubmittedCommands.Reset();
+}
+
+void FRiveTextureAtlas::MarkDirty(const FRiveAtlasRenderTarget& InTarget)
+{
+    if (Pages.IsValidIndex(InTarget.PageIndex))
+    {
+        Pages[InTarget.PageIndex].bDirty = true;
+    }
+}
+
+URiveTexture* FRiveTextureAtlas::GetPageTexture(int32 InPageIndex) const
+{
+    return Pages.IsValidIndex(InPageIndex) ? Pages[InPageIndex].Texture.Get()
+                                           : nullptr;
+}
+
+bool FRiveTextureAtlas::Allocate(FPage& Page,
+                                 const FIntPoint& InSize,
+                                 FCell& OutCell) const
+{
+    const FIntPoint Size = InSize + FIntPoint(2 * AtlasPadding);
+
+    // a freed cell wasting at most half of its area
+    int32 BestFreeCell = INDEX_NONE;
+    for (int32 Index = 0; Index < Page.FreeCells.Num(); ++Index)
+    {
+        const FIntPoint& CellSize = Page.FreeCells[Index].Size;
+        if (CellSize.X >= Size.X && CellSize.Y >= Size.Y &&
+            CellSize.X * CellSize.Y <= Size.X * Size.Y * 2 &&
+            (BestFreeCell == INDEX_NONE ||
+             CellSize.X * CellSize.Y <
+                 Page.FreeCells[BestFreeCell].Size.X *
+                     Page.FreeCells[BestFreeCell].Size.Y))
+        {
+            BestFreeCell = Index;
+        }
+    }
+
+    if (BestFreeCell != INDEX_NONE)
+    {
+        OutCell = Page.FreeCells[BestFreeCell];
+        Page.FreeCells.RemoveAtSwap(BestFreeCell);
+        return true;
+    }
+
+    // the lowest shelf the cell fits in without wasting more than half of the
+    // shelf height
+    FShelf* BestShelf = nullptr;
+    for (FShelf& Shelf : Page.Shelves)
+    {
+        if (Shelf.Height >= Size.Y && Shelf.Height <= Size.Y * 2 &&
+            Shelf.UsedWidth + Size.X <= PageSize &&
+            (!BestShelf || Shelf.Height < BestShelf->Height))
+        {
+            BestShelf = &Shelf;
+        }
+    }
+
+    if (!BestShelf)
+    {
+        if (Page.UsedHeight + Size.Y > PageSize || Size.X > PageSize)
+        {
+            return false;
+        }
+
+        BestShelf = &Page.Shelves.AddDefaulted_GetRef();
+        BestShelf->Y = Page.UsedHeight;
+        BestShelf->Height = Size.Y;
+        Page.UsedHeight += Size.Y;
+    }
+
+    // the cell keeps the whole shelf height so it can be reused by a taller
+    // target later on
+    OutCell.Position = FIntPoint(BestShelf->UsedWidth, BestShelf->Y);
+    OutCell.Size = FIntPoint(Size.X, BestShelf->Height);
+    BestShelf->UsedWidth += Size.X;
+    return true;
+}
+
+int32 FRiveTextureAtlas::AddPage()
+{
+    if (!IRiveRendererModule::IsAvailable())
+    {
+        return INDEX_NONE;
+    }
+
+    IRiveRenderer* RiveRenderer = IRiveRendererModule::Get().GetRenderer();
+    if (!RiveRenderer)
+    {
+        return INDEX_NONE;
+    }
+
+    if (Pages.Num() == 0)
+    {
+        PageSize = FMath::RoundUpToPowerOfTwo(FMath::Clamp(
+            GetDefault<URiveRendererSettings>()->TextureAtlasPageSize,
+            256,
+            4096));
+        PageSize = FMath::Min(PageSize, RIVE_MAX_TEX_RESOLUTION);
+    }
+
+    if (!PreTickHandle.IsValid() && FSlateApplication::IsInitialized())
+    {
+        PreTickHandle = FSlateApplication::Get().OnPreTick().AddRaw(
+            this,
+            &FRiveTextureAtlas::Flush);
+    }
+
+    FPage& Page = Pages.AddDefaulted_GetRef();
+    Page.Texture = NewObject<URiveTexture>(GetTransientPackage(),
+                                           NAME_None,
+                                           RF_Transient);
+    Page.RenderTarget =
+        RiveRenderer->CreateTextureTarget_GameThread(Page.Texture->GetFName(),
+                                                     Page.Texture);
+
+    // same order as URiveTextureObject, the target has to follow the page
+    // resource
+    TWeakPtr<IRiveRenderTarget> WeakRenderTarget = Page.RenderTarget;
+    Page.Texture->OnResourceInitializedOnRenderThread.AddLambda(
+        [WeakRenderTarget](FRHICommandListImmediate& RHICmdList,
+                           FTextureRHIRef& NewResource) {
+            if (const TSharedPtr<IRiveRenderTarget> RenderTarget =
+                    WeakRenderTarget.Pin())
+            {
+                RenderTarget->CacheTextureTarget_RenderThread(RHICmdList,
+                                                              NewResource);
+            }
+        });
+    Page.RenderTarget->SetClearColor(FLinearColor::Transparent);
+    Page.Texture->ResizeRenderTargets(FIntPoint(PageSize, PageSize));
+    Page.RenderTarget->Initialize();
+    return Pages.Num() - 1;
+}
+
+void FRiveTextureAtlas::Flush(float InDeltaSeconds)
+{
+    for (FPage& Page : Pages)
+    {
+        if (Page.bDirty)
+        {
+            RenderPage(Page);
+        }
+    }
+}
+
+void FRiveTextureAtlas::RenderPage(FPage& Page)
+{
+#if WITH_RIVE
+    Page.bDirty = false;
+
+    IRiveRenderTarget& RenderTarget = *Page.RenderTarget;
+    for (int32 Index = Page.Entries.Num() - 1; Index >= 0; --Index)
+    {
+        const TSharedPtr<FRiveAtlasRenderTarget> Target =
+            Page.Entries[Index].Target.Pin();
+        if (!Target)
+        {
+            Page.FreeCells.Add(Page.Entries[Index].Cell);
+            Page.Entries.RemoveAtSwap(Index);
+            continue;
+        }
+
+        RenderTarget.Save();
+        RenderTarget.Translate(FVector2f(Target->CellPosition));
+        for (const FRiveRenderCommand& RenderCommand :
+             Target->SubmittedCommands)
+        {
+            switch (RenderCommand.Type)
+            {
+                case ERiveRenderCommandType::Save:
+                    RenderTarget.Save();
+                    break;
+                case ERiveRenderCommandType::Restore:
+                    RenderTarget.Restore();
+                    break;
+                case ERiveRenderCommandType::Transform:
+                    RenderTarget.Transform(RenderCommand.X,
+                                           RenderCommand.Y,
+                                           RenderCommand.X2,
+                                           RenderCommand.Y2,
+                                           RenderCommand.TX,
+                                           RenderCommand.TY);
+                    break;
+                case ERiveRenderCommandType::Translate:
+                    RenderTarget.Translate(
+                        FVector2f(RenderCommand.TX, RenderCommand.TY));
+                    break;
+                case ERiveRenderCommandType::AlignArtboard:
+                    RenderTarget.Align(
+                        FBox2f(FVector2f(RenderCommand.TX, RenderCommand.TY),
+                               FVector2f(RenderCommand.X2, RenderCommand.Y2)),
+                        RenderCommand.FitType,
+                        FVector2f(RenderCommand.X, RenderCommand.Y),
+                        RenderCommand.ScaleFactor,
+                        RenderCommand.NativeArtboard);
+                    break;
+                case ERiveRenderCommandType::DrawArtboard:
+                    RenderTarget.Draw(RenderCommand.NativeArtboard);
+                    break;
+                default:
+                    break;
+            }
+        }
+        RenderTarget.Restore();
+    }
+
+    // a page without cells is still submitted once so its old cells are
+    // cleared, the frame is skipped when nothing was recorded
+    if (Page.Entries.Num() == 0)
+    {
+        Page.Shelves.Reset();
+        Page.FreeCells.Reset();
+        Page.UsedHeight = 0;
+        RenderTarget.Save();
+        RenderTarget.Restore();
+    }
+
+    RenderTarget.SubmitAndClear();
+#endif // WITH_RIVE
+}
+
+void FRiveTextureAtlas::AddReferencedObjects(FReferenceCollector& Collector)
+{
+    for (FPage& Page : Pages)
+    {
+        Collector.AddReferencedObject(Page.Texture);
+    }
+}
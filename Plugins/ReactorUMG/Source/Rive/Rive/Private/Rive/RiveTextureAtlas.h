@@ -0,0 +1,171 @@
+// Copyright Rive, Inc. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IRiveRenderTarget.h"
+#include "RiveRenderCommand.h"
+#include "UObject/GCObject.h"
+
+class URiveTexture;
+class FRiveTextureAtlas;
+
+/**
+ * Render target of a texture object drawing into a cell of a shared atlas
+ * page. It records the commands of its artboard like FRiveRenderTarget, in
+ * cell space, and FRiveTextureAtlas replays them into the page.
+ */
+class FRiveAtlasRenderTarget : public IRiveRenderTarget
+{
+public:
+    virtual void Initialize() override {}
+
+    virtual void CacheTextureTarget_RenderThread(
+        FRHICommandListImmediate& RHICmdList,
+        const FTextureRHIRef& InRHIResource) override
+    {}
+
+    virtual uint32 GetWidth() const override { return CellSize.X; }
+    virtual uint32 GetHeight() const override { return CellSize.Y; }
+
+    // the page is cleared to transparent, every cell shares it
+    virtual void SetClearColor(const FLinearColor& InColor) override {}
+
+#if WITH_RIVE
+    virtual void Submit() override;
+    virtual void SubmitAndClear() override;
+    virtual void Save() override;
+    virtual void Restore() override;
+    virtual void Transform(float X1,
+                           float Y1,
+                           float X2,
+                           float Y2,
+                           float TX,
+                           float TY) override;
+    virtual void Translate(const FVector2f& InVector) override;
+    virtual void Draw(rive::Artboard* InArtboard) override;
+    virtual void Align(const FBox2f& InBox,
+                       ERiveFitType InFit,
+                       const FVector2f& InAlignment,
+                       float InScaleFactor,
+                       rive::Artboard* InArtboard) override;
+    virtual void Align(ERiveFitType InFit,
+                       const FVector2f& InAlignment,
+                       float InScaleFactor,
+                       rive::Artboard* InArtboard) override;
+    virtual FMatrix GetTransformMatrix() const override;
+    virtual void RegisterRenderCommand(
+        RiveRenderFunction RenderFunction) override;
+#endif // WITH_RIVE
+
+    /**
+     * @return the page this target renders into, nullptr until it is sized
+     */
+    URiveTexture* GetTexture() const;
+
+    /**
+     * @return the cell of the page in normalized coordinates
+     */
+    FBox2f GetUVRegion() const;
+
+    bool HasCell() const { return PageIndex != INDEX_NONE; }
+
+private:
+    friend class FRiveTextureAtlas;
+
+    TArray<FRiveRenderCommand> RenderCommands;
+
+    // the last submitted frame, replayed every time the page is redrawn
+    TArray<FRiveRenderCommand> SubmittedCommands;
+
+    int32 PageIndex = INDEX_NONE;
+    FIntPoint CellPosition = FIntPoint::ZeroValue;
+    FIntPoint CellSize = FIntPoint::ZeroValue;
+};
+
+/**
+ * Packs the render targets of small texture objects into shared pages, so a
+ * screen full of small rive widgets renders in one BeginFrame / EndFrame pass
+ * per page instead of one per widget. Pages are redrawn once per frame before
+ * slate ticks, a page is filled shelf by shelf and freed cells are reused.
+ * Game thread only.
+ */
+class FRiveTextureAtlas : public FGCObject
+{
+public:
+    static FRiveTextureAtlas& Get();
+
+    /**
+     * @return the largest width/height of a cell
+     */
+    int32 GetMaxImageSize() const;
+
+    TSharedRef<FRiveAtlasRenderTarget> CreateRenderTarget();
+
+    /**
+     * Moves the target to a cell of the given size
+     * @return false if the size does not fit in the atlas, the target is left
+     * without a cell
+     */
+    bool Resize(FRiveAtlasRenderTarget& InTarget, const FIntPoint& InSize);
+
+    void Release(FRiveAtlasRenderTarget& InTarget);
+
+    void MarkDirty(const FRiveAtlasRenderTarget& InTarget);
+
+    URiveTexture* GetPageTexture(int32 InPageIndex) const;
+
+    int32 GetPageSize() const { return PageSize; }
+
+    virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+
+    virtual FString GetReferencerName() const override
+    {
+        return TEXT("FRiveTextureAtlas");
+    }
+
+private:
+    struct FShelf
+    {
+        int32 Y = 0;
+        int32 Height = 0;
+        int32 UsedWidth = 0;
+    };
+
+    struct FCell
+    {
+        FIntPoint Position = FIntPoint::ZeroValue;
+        FIntPoint Size = FIntPoint::ZeroValue;
+    };
+
+    struct FEntry
+    {
+        TWeakPtr<FRiveAtlasRenderTarget> Target;
+        FCell Cell;
+    };
+
+    struct FPage
+    {
+        TObjectPtr<URiveTexture> Texture;
+        TSharedPtr<IRiveRenderTarget> RenderTarget;
+        TArray<FShelf> Shelves;
+        int32 UsedHeight = 0;
+        TArray<FCell> FreeCells;
+        TArray<FEntry> Entries;
+        bool bDirty = false;
+    };
+
+    bool Allocate(FPage& Page, const FIntPoint& InSize, FCell& OutCell) const;
+
+    int32 AddPage();
+
+    void Flush(float InDeltaSeconds);
+
+    void RenderPage(FPage& Page);
+
+    TArray<FPage> Pages;
+
+    int32 PageSize = 0;
+
+    FDelegateHandle PreTickHandle;
+};
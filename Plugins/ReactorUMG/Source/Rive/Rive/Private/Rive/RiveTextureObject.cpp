@@ -12,6 +12,8 @@
 #include "Async/Async.h"
 #include "RenderingThread.h"
 #include "Rive/RiveFile.h"
+#include "Rive/RiveScheduler.h"
+#include "Rive/RiveTextureAtlas.h"
 
 #if WITH_RIVE
 THIRD_PARTY_INCLUDES_START
@@ -33,6 +35,12 @@ void URiveTextureObject::BeginDestroy()
 
     bIsRendering = false;
     OnRiveReady.Clear();
+    if (AtlasRenderTarget)
+    {
+        // the page must not replay the commands of a destroyed artboard
+        FRiveTextureAtlas::Get().Release(*AtlasRenderTarget);
+        AtlasRenderTarget.Reset();
+    }
     RiveRenderTarget.Reset();
 
     if (IsValid(Artboard))
@@ -86,17 +94,76 @@ void URiveTextureObject::Tick(float InDeltaSeconds)
     }
 
 #if WITH_RIVE
-    if (bIsRendering)
+    float DeltaSeconds = InDeltaSeconds;
+    if (bIsRendering && ShouldUpdate(DeltaSeconds))
     {
-        if (GetArtboard())
+        // an artboard that did not change keeps its last frame
+        if (GetArtboard() && Artboard->Tick(DeltaSeconds))
         {
-            Artboard->Tick(InDeltaSeconds);
             RiveRenderTarget->SubmitAndClear();
         }
     }
 #endif // WITH_RIVE
 }
 
+void URiveTextureObject::NotifyPainted(const FVector2D& InAbsoluteSize)
+{
+    LastPaintedFrame = GFrameCounter;
+    PaintedSize = InAbsoluteSize;
+}
+
+bool URiveTextureObject::ShouldUpdate(float& InOutDeltaSeconds)
+{
+    // tiny textures are updated at most this many frames apart
+    constexpr int32 MaxSkippedUpdates = 8;
+
+    FRiveScheduler& Scheduler = FRiveScheduler::Get();
+    Scheduler.Tick();
+    if (!Scheduler.ShouldStep(
+            MaxUpdateRate, LastSchedulerStep, InOutDeltaSeconds))
+    {
+        return false;
+    }
+
+    if (UpdatePolicy == ERiveUpdatePolicy::Always)
+    {
+        return true;
+    }
+
+    // tickables run before slate paints, a texture painted last frame is
+    // still on screen
+    if (UpdatePolicy == ERiveUpdatePolicy::Paused ||
+        LastPaintedFrame + 1 < GFrameCounter)
+    {
+        SkippedUpdates = 0;
+        SkippedDeltaSeconds = 0.f;
+        return false;
+    }
+
+    if (UpdatePolicy == ERiveUpdatePolicy::WhenVisible)
+    {
+        return true;
+    }
+
+    const float OnScreenSize =
+        FMath::Max(static_cast<float>(PaintedSize.GetMax()), 1.f);
+    const int32 Interval =
+        OnScreenSize >= FullRateSize
+            ? 1
+            : FMath::Min(FMath::CeilToInt(FullRateSize / OnScreenSize),
+                         MaxSkippedUpdates);
+    SkippedDeltaSeconds += InOutDeltaSeconds;
+    if (++SkippedUpdates < Interval)
+    {
+        return false;
+    }
+
+    InOutDeltaSeconds = SkippedDeltaSeconds;
+    SkippedUpdates = 0;
+    SkippedDeltaSeconds = 0.f;
+    return true;
+}
+
 #if WITH_EDITOR
 void URiveTextureObject::OnBeginPIE(bool bIsSimulating)
 {
@@ -230,6 +297,13 @@ void URiveTextureObject::OnRiveFileInitialized(bool bSuccess)
         else
             Artboard->Reinitialize(true);
 
+        if (AtlasRenderTarget)
+        {
+            FRiveTextureAtlas::Get().Release(*AtlasRenderTarget);
+            AtlasRenderTarget.Reset();
+        }
+
+        // ResizeRenderTargets moves small textures into the atlas
         RiveRenderTarget.Reset();
         RiveRenderTarget =
             RiveRenderer->CreateTextureTarget_GameThread(GetFName(), this);
@@ -285,6 +359,112 @@ void URiveTextureObject::OnRiveFileInitialized(bool bSuccess)
     }
 }
 
+void URiveTextureObject::ResizeRenderTargets(FIntPoint InNewSize)
+{
+    // the resized target is blank until the artboard renders again
+    if (IsValid(Artboard))
+    {
+        Artboard->MarkDirty();
+    }
+
+    if (CanUseTextureAtlas(InNewSize))
+    {
+        if (!AtlasRenderTarget)
+        {
+            SetUseAtlasRenderTarget(true);
+        }
+
+        if (FRiveTextureAtlas::Get().Resize(*AtlasRenderTarget, InNewSize))
+        {
+            Size = InNewSize.ComponentMax(FIntPoint(1, 1));
+            SizeX = Size.X;
+            SizeY = Size.Y;
+            return;
+        }
+    }
+
+    const bool bLeftAtlas = AtlasRenderTarget.IsValid();
+    if (bLeftAtlas)
+    {
+        SetUseAtlasRenderTarget(false);
+    }
+
+    Super::ResizeRenderTargets(InNewSize);
+
+    if (bLeftAtlas)
+    {
+        RiveRenderTarget->Initialize();
+    }
+}
+
+UTexture* URiveTextureObject::GetAtlasTexture() const
+{
+    return AtlasRenderTarget ? AtlasRenderTarget->GetTexture() : nullptr;
+}
+
+FBox2f URiveTextureObject::GetAtlasUVRegion() const
+{
+    return AtlasRenderTarget
+               ? AtlasRenderTarget->GetUVRegion()
+               : FBox2f(FVector2f::ZeroVector, FVector2f::UnitVector);
+}
+
+bool URiveTextureObject::CanUseTextureAtlas(const FIntPoint& InSize) const
+{
+    if (!bUseTextureAtlas || !RiveRenderTarget || !IsValid(Artboard))
+    {
+        return false;
+    }
+
+    // other fit types may draw outside of the texture, into the neighbouring
+    // cells
+    switch (RiveDescriptor.FitType)
+    {
+        case ERiveFitType::Fill:
+        case ERiveFitType::Contain:
+        case ERiveFitType::ScaleDown:
+        case ERiveFitType::Layout:
+            break;
+        default:
+            return false;
+    }
+
+    const int32 MaxImageSize = FRiveTextureAtlas::Get().GetMaxImageSize();
+    return InSize.X <= MaxImageSize && InSize.Y <= MaxImageSize;
+}
+
+void URiveTextureObject::SetUseAtlasRenderTarget(bool bInUseAtlas)
+{
+    // frames of the previous target may still be in flight
+    FlushRenderingCommands();
+
+    if (bInUseAtlas)
+    {
+        AtlasRenderTarget = FRiveTextureAtlas::Get().CreateRenderTarget();
+        RiveRenderTarget = AtlasRenderTarget;
+
+        // nothing samples this texture while it is in the atlas
+        if (CurrentResource)
+        {
+            ReleaseResource();
+            CurrentResource = nullptr;
+        }
+    }
+    else
+    {
+        FRiveTextureAtlas::Get().Release(*AtlasRenderTarget);
+        AtlasRenderTarget.Reset();
+
+        // the resource is created again by ResizeRenderTargets
+        RiveRenderTarget =
+            IRiveRendererModule::Get().GetRenderer()
+                ->CreateTextureTarget_GameThread(GetFName(), this);
+        RiveRenderTarget->SetClearColor(ClearColor);
+    }
+
+    Artboard->SetRenderTarget(RiveRenderTarget);
+}
+
 #if WITH_EDITOR
 void URiveTextureObject::PostEditChangeChainProperty(
     FPropertyChangedChainEvent& PropertyChangedEvent)
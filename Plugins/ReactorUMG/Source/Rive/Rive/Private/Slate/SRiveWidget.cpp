@@ -83,6 +83,47 @@ void SRiveWidget::OnArrangeChildren(const FGeometry& AllottedGeometry,
     }
 }
 
+int32 SRiveWidget::OnPaint(const FPaintArgs& Args,
+                           const FGeometry& AllottedGeometry,
+                           const FSlateRect& MyCullingRect,
+                           FSlateWindowElementList& OutDrawElements,
+                           int32 LayerId,
+                           const FWidgetStyle& InWidgetStyle,
+                           bool bParentEnabled) const
+{
+    // slate does not paint collapsed or culled widgets, so this is what tells
+    // the texture object it is visible
+    if (URiveTextureObject* RiveTextureObject =
+            Cast<URiveTextureObject>(RiveTexture))
+    {
+        RiveTextureObject->NotifyPainted(AllottedGeometry.GetAbsoluteSize());
+
+        // a texture object in the texture atlas is drawn from its page
+        if (RiveTextureBrush)
+        {
+            UTexture* AtlasTexture = RiveTextureObject->GetAtlasTexture();
+            UObject* ResourceObject =
+                AtlasTexture ? static_cast<UObject*>(AtlasTexture)
+                             : RiveTexture;
+            if (RiveTextureBrush->GetResourceObject() != ResourceObject)
+            {
+                RiveTextureBrush->SetResourceObject(ResourceObject);
+            }
+            RiveTextureBrush->SetUVRegion(
+                AtlasTexture ? RiveTextureObject->GetAtlasUVRegion()
+                             : FBox2f(ForceInit));
+        }
+    }
+
+    return SCompoundWidget::OnPaint(Args,
+                                    AllottedGeometry,
+                                    MyCullingRect,
+                                    OutDrawElements,
+                                    LayerId,
+                                    InWidgetStyle,
+                                    bParentEnabled);
+}
+
 void SRiveWidget::SetRiveTexture(URiveTexture* InRiveTexture)
 {
     if (RiveImageView)
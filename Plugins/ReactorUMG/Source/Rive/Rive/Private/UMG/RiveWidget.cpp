@@ -380,6 +380,10 @@ void URiveWidget::Setup()
 #if WITH_EDITOR
     RiveTextureObject->bRenderInEditor = true;
 #endif
+    RiveTextureObject->UpdatePolicy = UpdatePolicy;
+    RiveTextureObject->FullRateSize = FullRateSize;
+    RiveTextureObject->MaxUpdateRate = MaxUpdateRate;
+    RiveTextureObject->bUseTextureAtlas = bUseTextureAtlas;
     RiveTextureObject->Initialize(RiveDescriptor);
     CheckArtboardSize();
 }
@@ -395,6 +399,27 @@ void URiveWidget::SetRiveDescriptor(const FRiveDescriptor& newDescriptor)
     Setup();
 }
 
+void URiveWidget::SetUpdatePolicy(ERiveUpdatePolicy InUpdatePolicy,
+                                  float InFullRateSize)
+{
+    UpdatePolicy = InUpdatePolicy;
+    FullRateSize = FMath::Max(InFullRateSize, 1.f);
+    if (RiveTextureObject)
+    {
+        RiveTextureObject->UpdatePolicy = UpdatePolicy;
+        RiveTextureObject->FullRateSize = FullRateSize;
+    }
+}
+
+void URiveWidget::SetMaxUpdateRate(float InMaxUpdateRate)
+{
+    MaxUpdateRate = FMath::Max(InMaxUpdateRate, 0.f);
+    if (RiveTextureObject)
+    {
+        RiveTextureObject->MaxUpdateRate = MaxUpdateRate;
+    }
+}
+
 void URiveWidget::CheckArtboardSize()
 {
     URiveArtboard* Artboard = GetArtboard();
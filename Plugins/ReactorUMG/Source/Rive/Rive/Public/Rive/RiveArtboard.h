@@ -119,6 +119,23 @@ public:
     UFUNCTION(BlueprintCallable, Category = Rive)
     void Draw();
 
+    /**
+     * Whether the next tick renders: the state machine is still animating, or
+     * an input, the size or the render target changed since the last render
+     */
+    UFUNCTION(BlueprintPure, Category = Rive)
+    bool IsDirty() const { return bIsDirty; }
+
+    /**
+     * Renders the artboard on the next tick even if nothing changed
+     */
+    UFUNCTION(BlueprintCallable, Category = Rive)
+    void MarkDirty() const { bIsDirty = true; }
+
+    // when false every tick renders, even an artboard that settled
+    UPROPERTY(BlueprintReadWrite, Category = Rive)
+    bool bSkipCleanRenders = true;
+
     UFUNCTION(BlueprintCallable, Category = Rive)
     void FireTrigger(const FString& InPropertyName) const;
     UFUNCTION(BlueprintCallable, Category = Rive)
@@ -241,11 +258,17 @@ public:
         const TSharedPtr<IRiveRenderTarget>& InRiveRenderTarget)
     {
         RiveRenderTarget = InRiveRenderTarget;
+        MarkDirty();
     }
 
     bool IsInitialized() const { return bIsInitialized; }
 
-    void Tick(float InDeltaSeconds);
+    /**
+     * Advances the state machine and renders the artboard
+     * @return false if the render was skipped as nothing changed, see
+     * IsDirty
+     */
+    bool Tick(float InDeltaSeconds);
     /**
      * Implementation(s)
      */
@@ -340,4 +363,9 @@ protected:
     TArray<FRiveEvent> TickRiveReportedEvents;
 
     bool bIsReceivingInput = false;
+
+    mutable bool bIsDirty = true;
+
+    // the state machine did not settle on its last advance
+    bool bIsAnimating = false;
 };
@@ -21,6 +21,7 @@ THIRD_PARTY_INCLUDES_END
 class URiveAsset;
 class URiveArtboard;
 class URiveViewModel;
+class IRiveRenderer;
 
 /**
  *
@@ -102,6 +103,9 @@ public:
 #endif
 
 private:
+#if WITH_RIVE
+    void OnNativeFileImported();
+#endif // WITH_RIVE
     void BroadcastInitializationResult(bool bSuccess);
     TOptional<bool> WasLastInitializationSuccessful{};
     FOnRiveFileInitializationResult OnInitializedOnceDelegate;
@@ -182,6 +186,29 @@ public:
 
     void PrintStats() const;
 
+#if WITH_RIVE
+    /**
+     * Imports riv bytes loaded at runtime, without editor import data
+     * @param InNativeFile imported from InRiveFileData by ImportNativeFile,
+     * the file is imported once the renderer is ready if null
+     */
+    void RuntimeImport(TArray<uint8>&& InRiveFileData,
+                       std::unique_ptr<rive::File> InNativeFile = nullptr);
+
+    /**
+     * Imports riv bytes on any thread. In band assets are decoded by the
+     * renderer instead of being loaded into URiveAssets
+     * @param InAssetLoader resolves out of band assets, it is called on the
+     * importing thread and must not create UObjects
+     * @return null if the renderer is not initialized yet or the import
+     * failed
+     */
+    static std::unique_ptr<rive::File> ImportNativeFile(
+        IRiveRenderer* InRiveRenderer,
+        const TArray<uint8>& InRiveFileData,
+        rive::FileAssetLoader* InAssetLoader = nullptr);
+#endif // WITH_RIVE
+
 #if WITH_EDITOR
 
     bool EditorImport(const FString& InRiveFilePath,
@@ -15,6 +15,7 @@ class IRiveRenderer;
 struct FAssetImportInfo;
 class URiveArtboard;
 class FRiveTextureResource;
+class FRiveAtlasRenderTarget;
 
 namespace rive
 {
@@ -27,6 +28,21 @@ class URiveAsset;
 class UUserWidget;
 class URiveFile;
 
+/**
+ * When a texture object advances and renders its artboard. Visibility is
+ * reported by the slate widget painting the texture, see NotifyPainted
+ */
+UENUM(BlueprintType)
+enum class ERiveUpdatePolicy : uint8
+{
+    Always = 0,
+    WhenVisible = 1,
+    // while visible, less often the further the on-screen size is below
+    // FullRateSize
+    ScaledBySize = 2,
+    Paused = 3,
+};
+
 /**
  * This class represents the logical side of a single RiveTexture /
  * RenderTarget. It implements the logic to instantiate and tick an artboard
@@ -119,6 +135,58 @@ public:
     UPROPERTY(BlueprintAssignable, Category = Rive)
     FRiveReadyDelegate OnRiveReady;
 
+    /**
+     * Called by the slate widget showing this texture every time it is
+     * painted
+     * @param InAbsoluteSize on-screen size in pixels
+     */
+    void NotifyPainted(const FVector2D& InAbsoluteSize);
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Rive)
+    ERiveUpdatePolicy UpdatePolicy = ERiveUpdatePolicy::Always;
+
+    // on-screen size in pixels from which ScaledBySize updates every frame
+    UPROPERTY(EditAnywhere,
+              BlueprintReadWrite,
+              Category = Rive,
+              meta = (ClampMin = 1))
+    float FullRateSize = 128.f;
+
+    /**
+     * Updates per second, 0 to update every frame. Texture objects with the
+     * same rate update on the same frames, see Rive.MaxUpdateRate to cap
+     * every texture object
+     */
+    UPROPERTY(EditAnywhere,
+              BlueprintReadWrite,
+              Category = Rive,
+              meta = (ClampMin = 0))
+    float MaxUpdateRate = 0.f;
+
+    /**
+     * Renders into a cell of a page shared with other small texture objects,
+     * see URiveRendererSettings. Only used with fit types that keep the
+     * artboard inside the texture, and while the texture is not larger than
+     * the max atlas image size
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Rive)
+    bool bUseTextureAtlas = false;
+
+    using Super::ResizeRenderTargets;
+    virtual void ResizeRenderTargets(FIntPoint InNewSize) override;
+
+    /**
+     * @return the atlas page to sample instead of this texture, nullptr when
+     * rendering into this texture
+     */
+    UTexture* GetAtlasTexture() const;
+
+    /**
+     * @return the region of GetAtlasTexture to sample, in normalized
+     * coordinates
+     */
+    FBox2f GetAtlasUVRegion() const;
+
 protected:
     void OnRiveRendererInitialized(IRiveRenderer* InRiveRenderer);
     void OnResourceInitialized_RenderThread(
@@ -126,6 +194,12 @@ protected:
         FTextureRHIRef& NewResource) const;
     void OnRiveFileInitialized(bool bSuccess);
 
+    /**
+     * Applies the max update rate and the update policy
+     * @param InOutDeltaSeconds the time to advance the artboard by
+     */
+    bool ShouldUpdate(float& InOutDeltaSeconds);
+
 public:
     UPROPERTY(EditAnywhere, Transient, Category = Rive)
     bool bIsRendering = false;
@@ -152,8 +226,18 @@ private:
     UPROPERTY(EditAnywhere, Category = Rive)
     FLinearColor ClearColor = FLinearColor::Transparent;
 
+    bool CanUseTextureAtlas(const FIntPoint& InSize) const;
+
+    /**
+     * Switches the artboard between an atlas cell and this texture
+     */
+    void SetUseAtlasRenderTarget(bool bInUseAtlas);
+
     TSharedPtr<IRiveRenderTarget> RiveRenderTarget;
 
+    // set while RiveRenderTarget draws into the texture atlas
+    TSharedPtr<FRiveAtlasRenderTarget> AtlasRenderTarget;
+
     UPROPERTY(Transient,
               BlueprintReadOnly,
               Category = Rive,
@@ -170,4 +254,10 @@ private:
     void InitializeAudioEngine();
 
     FDelegateHandle AudioEngineLambdaHandle;
+
+    uint64 LastPaintedFrame = 0;
+    FVector2D PaintedSize = FVector2D::ZeroVector;
+    int32 SkippedUpdates = 0;
+    float SkippedDeltaSeconds = 0.f;
+    int64 LastSchedulerStep = INDEX_NONE;
 };
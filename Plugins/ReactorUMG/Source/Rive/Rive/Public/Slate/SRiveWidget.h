@@ -36,6 +36,14 @@ public:
         const FGeometry& AllottedGeometry,
         FArrangedChildren& ArrangedChildren) const override;
 
+    virtual int32 OnPaint(const FPaintArgs& Args,
+                          const FGeometry& AllottedGeometry,
+                          const FSlateRect& MyCullingRect,
+                          FSlateWindowElementList& OutDrawElements,
+                          int32 LayerId,
+                          const FWidgetStyle& InWidgetStyle,
+                          bool bParentEnabled) const override;
+
     void SetRiveTexture(URiveTexture* InRiveTexture);
     FVector2D GetSize();
     UWorld* GetWorld() const;
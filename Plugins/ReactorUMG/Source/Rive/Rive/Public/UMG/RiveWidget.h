@@ -7,6 +7,7 @@
 #include "rive/file.hpp"
 #include "Rive/RiveDescriptor.h"
 #include "Rive/RiveFile.h"
+#include "Rive/RiveTextureObject.h"
 #include "RiveWidget.generated.h"
 
 class FRiveStateMachine;
@@ -80,6 +81,41 @@ public:
     UFUNCTION(BlueprintCallable, Category = Rive)
     void SetRiveDescriptor(const FRiveDescriptor& newDescriptor);
 
+    UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = Rive)
+    ERiveUpdatePolicy UpdatePolicy = ERiveUpdatePolicy::WhenVisible;
+
+    UPROPERTY(BlueprintReadOnly,
+              EditAnywhere,
+              Category = Rive,
+              meta = (ClampMin = 1))
+    float FullRateSize = 128.f;
+
+    // renders into a page shared with other small rive widgets, see
+    // URiveTextureObject::bUseTextureAtlas
+    UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = Rive)
+    bool bUseTextureAtlas = false;
+
+    /**
+     * @param InFullRateSize on-screen size in pixels from which ScaledBySize
+     * updates every frame
+     */
+    UFUNCTION(BlueprintCallable, Category = Rive)
+    void SetUpdatePolicy(ERiveUpdatePolicy InUpdatePolicy,
+                         float InFullRateSize = 128.f);
+
+    // URiveTextureObject::MaxUpdateRate
+    UPROPERTY(BlueprintReadOnly,
+              EditAnywhere,
+              Category = Rive,
+              meta = (ClampMin = 0))
+    float MaxUpdateRate = 0.f;
+
+    /**
+     * @param InMaxUpdateRate updates per second, 0 to update every frame
+     */
+    UFUNCTION(BlueprintCallable, Category = Rive)
+    void SetMaxUpdateRate(float InMaxUpdateRate);
+
 #if WITH_EDITOR
     virtual void PostEditChangeChainProperty(
         FPropertyChangedChainEvent& PropertyChangedEvent) override;
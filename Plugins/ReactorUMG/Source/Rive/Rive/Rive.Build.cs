@@ -51,6 +51,7 @@ public class Rive : ModuleRules
 				"ApplicationCore",
 				"Core",
 				"CoreUObject",
+				"DeveloperSettings",
 				"Engine",
 				"Projects",
 				"RHI",
@@ -2,7 +2,11 @@
 
 #include "RiveRendererSettings.h"
 
-URiveRendererSettings::URiveRendererSettings() : bEnableRHITechPreview(true) {}
+URiveRendererSettings::URiveRendererSettings() :
+    bEnableRHITechPreview(true),
+    TextureAtlasPageSize(1024),
+    MaxTextureAtlasImageSize(256)
+{}
 
 #if WITH_EDITOR
 void URiveRendererSettings::PostInitProperties()
@@ -20,6 +20,27 @@ public:
               META = (Tooltip = "Not available on Apple platforms or UE 5.3."))
     bool bEnableRHITechPreview;
 
+    UPROPERTY(EditAnywhere,
+              config,
+              Category = "Rive Texture Atlas",
+              DisplayName = "Atlas Page Size",
+              META = (Tooltip = "Width and height of the shared pages small "
+                                "texture objects render into when they use the "
+                                "texture atlas.",
+                      ClampMin = 256,
+                      ClampMax = 4096))
+    int32 TextureAtlasPageSize;
+
+    UPROPERTY(EditAnywhere,
+              config,
+              Category = "Rive Texture Atlas",
+              DisplayName = "Max Atlas Image Size",
+              META = (Tooltip = "Texture objects larger than this keep a "
+                                "render target of their own even when they "
+                                "use the texture atlas.",
+                      ClampMin = 1))
+    int32 MaxTextureAtlasImageSize;
+
     virtual FName GetCategoryName() const override
     {
         return FName(TEXT("Rive"));
@@ -36,7 +36,10 @@
 #include "Slate/SMeshWidget.h"
 #include "Slate/SlateVectorArtData.h"
 #include "SlateMaterialBrush.h"
+#include "SpineBakedAnimation.h"
+#include "SpineSlotMesh.h"
 #include "SpineWidget.h"
+#include "SpineWidgetUpdater.h"
 #include <spine/spine.h>
 
 using namespace spine;
@@ -60,6 +63,7 @@ void SSpineWidget::Construct(const FArguments &args) {
 
 void SSpineWidget::SetData(USpineWidget *Widget) {
 	this->widget = Widget;
+	bMeshValid = false;
 	if (widget && widget->skeleton && widget->Atlas) {
 		Skeleton *skeleton = widget->skeleton;
 		skeleton->setToSetupPose();
@@ -74,9 +78,8 @@ void SSpineWidget::SetData(USpineWidget *Widget) {
 	}
 }
 
-static void setVertex(FSlateVertex *vertex, float x, float y, float u, float v, const FColor &color, const FVector2D &offset) {
-	vertex->Position.X = offset.X + x;
-	vertex->Position.Y = offset.Y + y;
+static FORCEINLINE void setVertex(FSlateVertex *vertex, const FVector2f &position, float u, float v, const FColor &color) {
+	vertex->Position = position;
 	vertex->TexCoords[0] = u;
 	vertex->TexCoords[1] = v;
 	vertex->TexCoords[2] = u;
@@ -90,316 +93,302 @@ static void setVertex(FSlateVertex *vertex, float x, float y, float u, float v,
 
 void SSpineWidget::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
 {
-	if (widget && widget->skeleton && widget->Atlas)
+	float deltaTime = 0;
+	if (!widget || !widget->skeleton || !widget->Atlas || !ShouldUpdate(AllottedGeometry, InCurrentTime, InDeltaTime, deltaTime))
 	{
-		widget->Tick(InDeltaTime);
+		return;
 	}
+
+	// a baked animation only looks up its next frame, there is nothing worth moving to a worker
+	const bool bBaked = widget->bakedAnimation && widget->bakedAnimation->IsReady();
+	if (bBaked || !FSpineWidgetUpdater::Get().Add(widget, deltaTime))
+	{
+		widget->Tick(deltaTime);
+	}
+}
+
+bool SSpineWidget::ShouldUpdate(const FGeometry &AllottedGeometry, double CurrentTime, float DeltaTime, float &OutDeltaTime)
+{
+	// tiny widgets are updated at most this many frames apart
+	static constexpr int32 MaxSkippedUpdates = 8;
+
+	switch (widget->UpdatePolicy)
+	{
+		case ESpineWidgetUpdatePolicy::Paused:
+			lastUpdateTime = CurrentTime;
+			return false;
+		case ESpineWidgetUpdatePolicy::Always:
+			OutDeltaTime = lastUpdateTime < 0 ? DeltaTime : static_cast<float>(CurrentTime - lastUpdateTime);
+			break;
+		case ESpineWidgetUpdatePolicy::ScaledBySize: {
+			const FVector2D absoluteSize = AllottedGeometry.GetAbsoluteSize();
+			const float onScreenSize = FMath::Max(static_cast<float>(absoluteSize.GetMax()), 1.0f);
+			const int32 interval = onScreenSize >= widget->FullRateSize ? 1
+				: FMath::Min(FMath::CeilToInt(widget->FullRateSize / onScreenSize), MaxSkippedUpdates);
+			skippedDeltaTime += DeltaTime;
+			if (++skippedUpdates < interval) return false;
+			OutDeltaTime = skippedDeltaTime;
+			skippedUpdates = 0;
+			skippedDeltaTime = 0;
+			break;
+		}
+		default:
+			OutDeltaTime = DeltaTime;
+	}
+
+	lastUpdateTime = CurrentTime;
+	return true;
 }
 
 int32 SSpineWidget::OnPaint(const FPaintArgs &Args, const FGeometry &AllottedGeometry, const FSlateRect &MyClippingRect, FSlateWindowElementList &OutDrawElements,
 							int32 LayerId, const FWidgetStyle &InWidgetStyle, bool bParentEnabled) const {
 
 	SSpineWidget *self = (SSpineWidget *) this;
-	UMaterialInstanceDynamic *MatNow = nullptr;
 
 	if (widget && widget->skeleton && widget->Atlas) {
 		widget->skeleton->getColor().set(widget->Color.R, widget->Color.G, widget->Color.B, widget->Color.A);
 
-		if (widget->atlasNormalBlendMaterials.Num() != widget->Atlas->atlasPages.Num()) {
-			widget->atlasNormalBlendMaterials.SetNum(0);
-			widget->pageToNormalBlendMaterial.Empty();
-			widget->atlasAdditiveBlendMaterials.SetNum(0);
-			widget->pageToAdditiveBlendMaterial.Empty();
-			widget->atlasMultiplyBlendMaterials.SetNum(0);
-			widget->pageToMultiplyBlendMaterial.Empty();
-			widget->atlasScreenBlendMaterials.SetNum(0);
-			widget->pageToScreenBlendMaterial.Empty();
-
-			for (int i = 0; i < widget->Atlas->atlasPages.Num(); i++) {
-				AtlasPage *currPage = widget->Atlas->GetAtlas()->getPages()[i];
-
-				UMaterialInstanceDynamic *material = UMaterialInstanceDynamic::Create(widget->NormalBlendMaterial, widget);
-				material->SetTextureParameterValue(widget->TextureParameterName, widget->Atlas->atlasPages[i]);
-				widget->atlasNormalBlendMaterials.Add(material);
-				widget->pageToNormalBlendMaterial.Add(currPage, material);
-
-				material = UMaterialInstanceDynamic::Create(widget->AdditiveBlendMaterial, widget);
-				material->SetTextureParameterValue(widget->TextureParameterName, widget->Atlas->atlasPages[i]);
-				widget->atlasAdditiveBlendMaterials.Add(material);
-				widget->pageToAdditiveBlendMaterial.Add(currPage, material);
-
-				material = UMaterialInstanceDynamic::Create(widget->MultiplyBlendMaterial, widget);
-				material->SetTextureParameterValue(widget->TextureParameterName, widget->Atlas->atlasPages[i]);
-				widget->atlasMultiplyBlendMaterials.Add(material);
-				widget->pageToMultiplyBlendMaterial.Add(currPage, material);
-
-				material = UMaterialInstanceDynamic::Create(widget->ScreenBlendMaterial, widget);
-				material->SetTextureParameterValue(widget->TextureParameterName, widget->Atlas->atlasPages[i]);
-				widget->atlasScreenBlendMaterials.Add(material);
-				widget->pageToScreenBlendMaterial.Add(currPage, material);
-			}
-		} else {
-			widget->pageToNormalBlendMaterial.Empty();
-			widget->pageToAdditiveBlendMaterial.Empty();
-			widget->pageToMultiplyBlendMaterial.Empty();
-			widget->pageToScreenBlendMaterial.Empty();
-
-			for (int i = 0; i < widget->Atlas->atlasPages.Num(); i++) {
-				AtlasPage *currPage = widget->Atlas->GetAtlas()->getPages()[i];
-
-				UTexture2D *texture = widget->Atlas->atlasPages[i];
-				UTexture *oldTexture = nullptr;
-
-				UMaterialInstanceDynamic *current = widget->atlasNormalBlendMaterials[i];
-				if (!current || !current->GetTextureParameterValue(widget->TextureParameterName, oldTexture) || oldTexture != texture) {
-					UMaterialInstanceDynamic *material = UMaterialInstanceDynamic::Create(widget->NormalBlendMaterial, widget);
-					material->SetTextureParameterValue(widget->TextureParameterName, texture);
-					widget->atlasNormalBlendMaterials[i] = material;
-				}
-				widget->pageToNormalBlendMaterial.Add(currPage, widget->atlasNormalBlendMaterials[i]);
-
-				current = widget->atlasAdditiveBlendMaterials[i];
-				if (!current || !current->GetTextureParameterValue(widget->TextureParameterName, oldTexture) || oldTexture != texture) {
-					UMaterialInstanceDynamic *material = UMaterialInstanceDynamic::Create(widget->AdditiveBlendMaterial, widget);
-					material->SetTextureParameterValue(widget->TextureParameterName, texture);
-					widget->atlasAdditiveBlendMaterials[i] = material;
-				}
-				widget->pageToAdditiveBlendMaterial.Add(currPage, widget->atlasAdditiveBlendMaterials[i]);
-
-				current = widget->atlasMultiplyBlendMaterials[i];
-				if (!current || !current->GetTextureParameterValue(widget->TextureParameterName, oldTexture) || oldTexture != texture) {
-					UMaterialInstanceDynamic *material = UMaterialInstanceDynamic::Create(widget->MultiplyBlendMaterial, widget);
-					material->SetTextureParameterValue(widget->TextureParameterName, texture);
-					widget->atlasMultiplyBlendMaterials[i] = material;
-				}
-				widget->pageToMultiplyBlendMaterial.Add(currPage, widget->atlasMultiplyBlendMaterials[i]);
-
-				current = widget->atlasScreenBlendMaterials[i];
-				if (!current || !current->GetTextureParameterValue(widget->TextureParameterName, oldTexture) || oldTexture != texture) {
-					UMaterialInstanceDynamic *material = UMaterialInstanceDynamic::Create(widget->ScreenBlendMaterial, widget);
-					material->SetTextureParameterValue(widget->TextureParameterName, texture);
-					widget->atlasScreenBlendMaterials[i] = material;
-				}
-				widget->pageToScreenBlendMaterial.Add(currPage, widget->atlasScreenBlendMaterials[i]);
+		if (HaveAtlasPagesChanged()) {
+			self->UpdateMaterials();
+		}
+
+		const FSlateRenderTransform transform = GetMeshTransform(AllottedGeometry);
+		if (!bMeshValid || meshPoseVersion != widget->poseVersion || meshColor != widget->Color) {
+			if (widget->bakedAnimation && widget->bakedFrame != INDEX_NONE) {
+				self->UpdateBakedMesh(transform, *widget->bakedAnimation, widget->bakedFrame);
+			} else {
+				self->UpdateMesh(transform, widget->skeleton);
 			}
+			self->bMeshValid = true;
+			self->meshPoseVersion = widget->poseVersion;
+			self->meshColor = widget->Color;
+			self->meshTransform = transform;
+		} else if (meshTransform != transform) {
+			self->UpdateVertices(transform);
+			self->meshTransform = transform;
 		}
 
-		self->UpdateMesh(LayerId, OutDrawElements, AllottedGeometry, widget->skeleton);
+		for (int32 i = 0; i < numMeshBatches; i++) {
+			self->Flush(LayerId, OutDrawElements, meshBatches[i]);
+		}
 	}
 
 	return LayerId;
 }
 
-void SSpineWidget::Flush(int32 LayerId, FSlateWindowElementList &OutDrawElements, const FGeometry &AllottedGeometry, int &Idx, TArray<FVector> &Vertices, TArray<int32> &Indices, TArray<FVector2D> &Uvs, TArray<FColor> &Colors, TArray<FVector> &Colors2, UMaterialInstanceDynamic *Material) {
-	if (Vertices.Num() == 0) return;
-	SSpineWidget *self = (SSpineWidget *) this;
-
-	const FVector2D widgetSize = AllottedGeometry.GetLocalSize();
-	const FVector2D sizeScale = widgetSize / FVector2D(boundsSize.X, boundsSize.Y);
-	const float setupScale = sizeScale.GetMin();
+static UMaterialInstanceDynamic *GetPageMaterial(UMaterialInstanceDynamic *Current, UMaterialInterface *Parent, UTexture2D *Texture, FName TextureParameterName, UObject *Outer) {
+	UTexture *currentTexture = nullptr;
+	if (Current && Current->GetTextureParameterValue(TextureParameterName, currentTexture) && currentTexture == Texture) return Current;
+	UMaterialInstanceDynamic *material = UMaterialInstanceDynamic::Create(Parent, Outer);
+	material->SetTextureParameterValue(TextureParameterName, Texture);
+	return material;
+}
 
-	for (int i = 0; i < Vertices.Num(); i++) {
-		Vertices[i] = (Vertices[i] + FVector(-boundsMin.X - boundsSize.X / 2, boundsMin.Y + boundsSize.Y / 2, 0)) * setupScale + FVector(widgetSize.X / 2, widgetSize.Y / 2, 0);
+void SSpineWidget::UpdateMaterials() {
+	const int32 numPages = widget->Atlas->atlasPages.Num();
+	widget->atlasNormalBlendMaterials.SetNum(numPages);
+	widget->atlasAdditiveBlendMaterials.SetNum(numPages);
+	widget->atlasMultiplyBlendMaterials.SetNum(numPages);
+	widget->atlasScreenBlendMaterials.SetNum(numPages);
+	widget->pageToNormalBlendMaterial.Empty();
+	widget->pageToAdditiveBlendMaterial.Empty();
+	widget->pageToMultiplyBlendMaterial.Empty();
+	widget->pageToScreenBlendMaterial.Empty();
+
+	// Materials whose page texture did not change are kept, so their brushes stay valid.
+	for (int32 i = 0; i < numPages; i++) {
+		AtlasPage *currPage = widget->Atlas->GetAtlas()->getPages()[i];
+		UTexture2D *texture = widget->Atlas->atlasPages[i];
+		const FName parameterName = widget->TextureParameterName;
+
+		widget->atlasNormalBlendMaterials[i] = GetPageMaterial(widget->atlasNormalBlendMaterials[i], widget->NormalBlendMaterial, texture, parameterName, widget);
+		widget->pageToNormalBlendMaterial.Add(currPage, widget->atlasNormalBlendMaterials[i]);
+
+		widget->atlasAdditiveBlendMaterials[i] = GetPageMaterial(widget->atlasAdditiveBlendMaterials[i], widget->AdditiveBlendMaterial, texture, parameterName, widget);
+		widget->pageToAdditiveBlendMaterial.Add(currPage, widget->atlasAdditiveBlendMaterials[i]);
+
+		widget->atlasMultiplyBlendMaterials[i] = GetPageMaterial(widget->atlasMultiplyBlendMaterials[i], widget->MultiplyBlendMaterial, texture, parameterName, widget);
+		widget->pageToMultiplyBlendMaterial.Add(currPage, widget->atlasMultiplyBlendMaterials[i]);
+
+		widget->atlasScreenBlendMaterials[i] = GetPageMaterial(widget->atlasScreenBlendMaterials[i], widget->ScreenBlendMaterial, texture, parameterName, widget);
+		widget->pageToScreenBlendMaterial.Add(currPage, widget->atlasScreenBlendMaterials[i]);
 	}
 
-	self->renderData.IndexData.SetNumUninitialized(Indices.Num());
-	SlateIndex *indexData = (SlateIndex *) renderData.IndexData.GetData();
-	for (int i = 0; i < Indices.Num(); i++) {
-		indexData[i] = (SlateIndex) Indices[i];
+	materialsAtlas = widget->Atlas->GetAtlas();
+	materialPages.Reset(numPages);
+	for (UTexture2D *page : widget->Atlas->atlasPages) {
+		materialPages.Add(page);
 	}
+	materialBrushes.Empty();
+	bMeshValid = false;
+}
 
-	self->renderData.VertexData.SetNumUninitialized(Vertices.Num());
-	FSlateVertex *vertexData = (FSlateVertex *) renderData.VertexData.GetData();
-	FVector2D offset = AllottedGeometry.GetAbsolutePositionAtCoordinates(FVector2D(0.0f, 0.0f));
-	FColor white = FColor(0xffffffff);
-	const FSlateRenderTransform &Transform = AllottedGeometry.GetAccumulatedRenderTransform();
+void SSpineWidget::Flush(int32 LayerId, FSlateWindowElementList &OutDrawElements, const FMeshBatch &Batch) {
+	if (Batch.vertices.Num() == 0 || !Batch.handle.IsValid()) return;
+	FSlateDrawElement::MakeCustomVerts(OutDrawElements, LayerId, Batch.handle, Batch.vertices, Batch.indices, nullptr, 0, 0);
+}
 
-	for (size_t i = 0; i < (size_t) Vertices.Num(); i++) {
-		setVertex(&vertexData[i], 0, 0, Uvs[i].X, Uvs[i].Y, Colors[i], Transform.TransformPoint(FVector2D(Vertices[i])));
+bool SSpineWidget::HaveAtlasPagesChanged() const {
+	if (materialsAtlas != widget->Atlas->GetAtlas() || materialPages.Num() != widget->Atlas->atlasPages.Num()) return true;
+	for (int32 i = 0; i < materialPages.Num(); i++) {
+		if (materialPages[i] != widget->Atlas->atlasPages[i]) return true;
 	}
+	return false;
+}
 
-	brush = &widget->Brush;
-	if (Material) {
-		renderData.Brush = MakeShareable(new SpineSlateMaterialBrush(*Material, FVector2D(64, 64)));
-		renderData.RenderingResourceHandle = FSlateApplication::Get().GetRenderer()->GetResourceHandle(*renderData.Brush);
+const FSlateResourceHandle &SSpineWidget::GetMaterialHandle(UMaterialInstanceDynamic *Material) {
+	FMaterialBrush &materialBrush = materialBrushes.FindOrAdd(Material);
+	if (!materialBrush.brush.IsValid()) {
+		materialBrush.brush = MakeShareable(new SpineSlateMaterialBrush(*Material, FVector2D(64, 64)));
+		materialBrush.handle = FSlateApplication::Get().GetRenderer()->GetResourceHandle(*materialBrush.brush);
 	}
+	return materialBrush.handle;
+}
 
-	if (renderData.RenderingResourceHandle.IsValid()) {
-		FSlateDrawElement::MakeCustomVerts(OutDrawElements, LayerId, renderData.RenderingResourceHandle, renderData.VertexData, renderData.IndexData, nullptr, 0, 0);
+UMaterialInstanceDynamic *SSpineWidget::FindMaterial(AtlasPage *Page, BlendMode BlendMode) const {
+	UMaterialInstanceDynamic *const *material;
+	switch (BlendMode) {
+		case BlendMode_Additive:
+			material = widget->pageToAdditiveBlendMaterial.Find(Page);
+			break;
+		case BlendMode_Multiply:
+			material = widget->pageToMultiplyBlendMaterial.Find(Page);
+			break;
+		case BlendMode_Screen:
+			material = widget->pageToScreenBlendMaterial.Find(Page);
+			break;
+		default:
+			material = widget->pageToNormalBlendMaterial.Find(Page);
 	}
+	return material ? *material : nullptr;
+}
 
-	Vertices.SetNum(0);
-	Indices.SetNum(0);
-	Uvs.SetNum(0);
-	Colors.SetNum(0);
-	Colors2.SetNum(0);
-	Idx++;
+FSlateRenderTransform SSpineWidget::GetMeshTransform(const FGeometry &AllottedGeometry) const {
+	// centers the skeleton bounds in the widget, scaled to fit, then applies the widget's render transform
+	const FVector2D widgetSize = AllottedGeometry.GetLocalSize();
+	const FVector2D sizeScale = widgetSize / FVector2D(boundsSize.X, boundsSize.Y);
+	const float setupScale = sizeScale.GetMin();
+	const FVector2f offset((-boundsMin.X - boundsSize.X / 2) * setupScale + widgetSize.X / 2,
+						   (boundsMin.Y + boundsSize.Y / 2) * setupScale + widgetSize.Y / 2);
+	return ::Concatenate(FSlateRenderTransform(setupScale, offset), AllottedGeometry.GetAccumulatedRenderTransform());
 }
 
-FVector2D SSpineWidget::ComputeDesiredSize(float X) const {
-	if (widget && widget->skeleton && widget->Atlas) {
-		return FVector2D(boundsSize.X, boundsSize.Y);
-	} else {
-		return FVector2D(256, 256);
-	}
+static FORCEINLINE FColor tintColor(const FColor &color, const FLinearColor &tint) {
+	return FColor(static_cast<uint8>(color.R * tint.R), static_cast<uint8>(color.G * tint.G), static_cast<uint8>(color.B * tint.B), static_cast<uint8>(color.A * tint.A));
 }
 
-void SSpineWidget::UpdateMesh(int32 LayerId, FSlateWindowElementList &OutDrawElements, const FGeometry &AllottedGeometry, Skeleton *Skeleton) {
-	TArray<FVector> vertices;
-	TArray<int32> indices;
-	TArray<FVector2D> uvs;
-	TArray<FColor> colors;
-	TArray<FVector> darkColors;
-
-	int idx = 0;
-	int meshSection = 0;
-	UMaterialInstanceDynamic *lastMaterial = nullptr;
-
-	SkeletonClipping &clipper = widget->clipper;
-	Vector<float> &worldVertices = widget->worldVertices;
-
-	float depthOffset = 0;
-	unsigned short quadIndices[] = {0, 1, 2, 0, 2, 3};
-
-	for (int i = 0; i < (int) Skeleton->getSlots().size(); ++i) {
-		Vector<float> *attachmentVertices = &worldVertices;
-		unsigned short *attachmentIndices = nullptr;
-		int numVertices;
-		int numIndices;
-		AtlasRegion *attachmentAtlasRegion = nullptr;
-		Color attachmentColor;
-		attachmentColor.set(1, 1, 1, 1);
-		float *attachmentUvs = nullptr;
-
-		Slot *slot = Skeleton->getDrawOrder()[i];
-		if (!slot->getBone().isActive()) {
-			clipper.clipEnd(*slot);
-			continue;
+void SSpineWidget::UpdateBakedMesh(const FSlateRenderTransform &Transform, const FSpineBakedAnimation &Animation, int32 FrameIndex) {
+	numMeshBatches = 0;
+	FMeshBatch *batch = nullptr;
+
+	const FSpineBakedAnimation::FFrame &frame = Animation.frames[FrameIndex];
+	const FLinearColor tint = widget->Color;
+	const bool bTinted = tint != FLinearColor::White;
+
+	for (const FSpineBakedAnimation::FSection &section : frame.sections) {
+		UMaterialInstanceDynamic *material = FindMaterial(section.page, section.blendMode);
+		if (!material) continue;
+
+		if (!batch || batch->material != material) {
+			if (numMeshBatches == meshBatches.Num()) meshBatches.AddDefaulted();
+			batch = &meshBatches[numMeshBatches++];
+			batch->material = material;
+			batch->handle = GetMaterialHandle(material);
+			batch->positions.Reset();
+			batch->vertices.Reset();
+			batch->indices.Reset();
 		}
 
-		Attachment *attachment = slot->getAttachment();
-		if (!attachment) {
-			clipper.clipEnd(*slot);
-			continue;
+		const int32 firstVertex = batch->vertices.Num();
+		batch->positions.Append(frame.positions.GetData() + section.firstVertex, section.numVertices);
+		batch->vertices.AddUninitialized(section.numVertices);
+		const FVector2f *positions = batch->positions.GetData() + firstVertex;
+		const FVector2f *uvs = frame.uvs.GetData() + section.firstVertex;
+		const FColor *colors = frame.colors.GetData() + section.firstVertex;
+		FSlateVertex *vertexData = batch->vertices.GetData() + firstVertex;
+		for (int32 j = 0; j < section.numVertices; j++) {
+			setVertex(&vertexData[j], Transform.TransformPoint(positions[j]), uvs[j].X, uvs[j].Y, bTinted ? tintColor(colors[j], tint) : colors[j]);
 		}
-		if (!attachment->getRTTI().isExactly(RegionAttachment::rtti) && !attachment->getRTTI().isExactly(MeshAttachment::rtti) && !attachment->getRTTI().isExactly(ClippingAttachment::rtti)) {
-			clipper.clipEnd(*slot);
-			continue;
+
+		const SlateIndex *sectionIndices = frame.indices.GetData() + section.firstIndex;
+		if (firstVertex == 0) {
+			batch->indices.Append(sectionIndices, section.numIndices);
+		} else {
+			const int32 firstIndex = batch->indices.Num();
+			batch->indices.AddUninitialized(section.numIndices);
+			SlateIndex *indexData = batch->indices.GetData() + firstIndex;
+			for (int32 j = 0; j < section.numIndices; j++) {
+				indexData[j] = (SlateIndex) (firstVertex + sectionIndices[j]);
+			}
 		}
+	}
+}
 
-		if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
-			RegionAttachment *regionAttachment = (RegionAttachment *) attachment;
-			attachmentColor.set(regionAttachment->getColor());
-			attachmentVertices->setSize(8, 0);
-			regionAttachment->computeWorldVertices(*slot, *attachmentVertices, 0, 2);
-			attachmentAtlasRegion = (AtlasRegion *) regionAttachment->getRegion();
-			attachmentIndices = quadIndices;
-			attachmentUvs = regionAttachment->getUVs().buffer();
-			numVertices = 4;
-			numIndices = 6;
-		} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
-			MeshAttachment *mesh = (MeshAttachment *) attachment;
-			attachmentColor.set(mesh->getColor());
-			attachmentVertices->setSize(mesh->getWorldVerticesLength(), 0);
-			mesh->computeWorldVertices(*slot, 0, mesh->getWorldVerticesLength(), attachmentVertices->buffer(), 0, 2);
-			attachmentAtlasRegion = (AtlasRegion *) mesh->getRegion();
-			attachmentIndices = mesh->getTriangles().buffer();
-			attachmentUvs = mesh->getUVs().buffer();
-			numVertices = mesh->getWorldVerticesLength() >> 1;
-			numIndices = mesh->getTriangles().size();
-		} else /* clipping */ {
-			ClippingAttachment *clip = (ClippingAttachment *) attachment;
-			clipper.clipStart(*slot, clip);
-			continue;
+void SSpineWidget::UpdateVertices(const FSlateRenderTransform &Transform) {
+	for (int32 i = 0; i < numMeshBatches; i++) {
+		FMeshBatch &batch = meshBatches[i];
+		const FVector2f *positions = batch.positions.GetData();
+		FSlateVertex *vertexData = batch.vertices.GetData();
+		for (int32 j = 0, n = batch.positions.Num(); j < n; j++) {
+			vertexData[j].Position = Transform.TransformPoint(positions[j]);
 		}
+	}
+}
+
+FVector2D SSpineWidget::ComputeDesiredSize(float X) const {
+	if (widget && widget->skeleton && widget->Atlas) {
+		return FVector2D(boundsSize.X, boundsSize.Y);
+	} else {
+		return FVector2D(256, 256);
+	}
+}
+
+void SSpineWidget::UpdateMesh(const FSlateRenderTransform &Transform, Skeleton *Skeleton) {
+	numMeshBatches = 0;
+	FMeshBatch *batch = nullptr;
 
+	ForEachSpineSlotMesh(*Skeleton, widget->clipper, widget->worldVertices, [&](const FSpineSlotMesh &Mesh) {
 		// if the user switches the atlas data while not having switched
 		// to the correct skeleton data yet, we won't find any regions.
 		// ignore regions for which we can't find a material
-		UMaterialInstanceDynamic *material = nullptr;
-		switch (slot->getData().getBlendMode()) {
-			case BlendMode_Normal:
-				if (!widget->pageToNormalBlendMaterial.Contains(attachmentAtlasRegion->page)) {
-					clipper.clipEnd(*slot);
-					continue;
-				}
-				material = widget->pageToNormalBlendMaterial[attachmentAtlasRegion->page];
-				break;
-			case BlendMode_Additive:
-				if (!widget->pageToAdditiveBlendMaterial.Contains(attachmentAtlasRegion->page)) {
-					clipper.clipEnd(*slot);
-					continue;
-				}
-				material = widget->pageToAdditiveBlendMaterial[attachmentAtlasRegion->page];
-				break;
-			case BlendMode_Multiply:
-				if (!widget->pageToMultiplyBlendMaterial.Contains(attachmentAtlasRegion->page)) {
-					clipper.clipEnd(*slot);
-					continue;
-				}
-				material = widget->pageToMultiplyBlendMaterial[attachmentAtlasRegion->page];
-				break;
-			case BlendMode_Screen:
-				if (!widget->pageToScreenBlendMaterial.Contains(attachmentAtlasRegion->page)) {
-					clipper.clipEnd(*slot);
-					continue;
-				}
-				material = widget->pageToScreenBlendMaterial[attachmentAtlasRegion->page];
-				break;
-			default:
-				if (!widget->pageToNormalBlendMaterial.Contains(attachmentAtlasRegion->page)) {
-					clipper.clipEnd(*slot);
-					continue;
-				}
-				material = widget->pageToNormalBlendMaterial[attachmentAtlasRegion->page];
+		UMaterialInstanceDynamic *material = FindMaterial(Mesh.region->page, Mesh.slot->getData().getBlendMode());
+		if (!material) return;
+
+		if (!batch || batch->material != material) {
+			if (numMeshBatches == meshBatches.Num()) meshBatches.AddDefaulted();
+			batch = &meshBatches[numMeshBatches++];
+			batch->material = material;
+			batch->handle = GetMaterialHandle(material);
+			batch->positions.Reset();
+			batch->vertices.Reset();
+			batch->indices.Reset();
 		}
 
-		if (clipper.isClipping()) {
-			clipper.clipTriangles(attachmentVertices->buffer(), attachmentIndices, numIndices, attachmentUvs, 2);
-			attachmentVertices = &clipper.getClippedVertices();
-			numVertices = clipper.getClippedVertices().size() >> 1;
-			attachmentIndices = clipper.getClippedTriangles().buffer();
-			numIndices = clipper.getClippedTriangles().size();
-			attachmentUvs = clipper.getClippedUVs().buffer();
-			if (clipper.getClippedTriangles().size() == 0) {
-				clipper.clipEnd(*slot);
-				continue;
-			}
+		const Color &skeletonColor = Skeleton->getColor();
+		const Color &slotColor = Mesh.slot->getColor();
+		const Color &attachmentColor = Mesh.attachmentColor;
+		uint8 r = static_cast<uint8>(skeletonColor.r * slotColor.r * attachmentColor.r * 255);
+		uint8 g = static_cast<uint8>(skeletonColor.g * slotColor.g * attachmentColor.g * 255);
+		uint8 b = static_cast<uint8>(skeletonColor.b * slotColor.b * attachmentColor.b * 255);
+		uint8 a = static_cast<uint8>(skeletonColor.a * slotColor.a * attachmentColor.a * 255);
+		const FColor color(r, g, b, a);
+
+		// positions, uvs and colors are written straight into the slate vertices in a single pass
+		const int32 firstVertex = batch->vertices.Num();
+		batch->positions.AddUninitialized(Mesh.numVertices);
+		batch->vertices.AddUninitialized(Mesh.numVertices);
+		FVector2f *positions = batch->positions.GetData() + firstVertex;
+		FSlateVertex *vertexData = batch->vertices.GetData() + firstVertex;
+		for (int j = 0; j < Mesh.numVertices; j++) {
+			positions[j] = FVector2f(Mesh.vertices[j << 1], -Mesh.vertices[(j << 1) + 1]);
+			setVertex(&vertexData[j], Transform.TransformPoint(positions[j]), Mesh.uvs[j << 1], Mesh.uvs[(j << 1) + 1], color);
 		}
 
-		if (lastMaterial != material) {
-			Flush(LayerId, OutDrawElements, AllottedGeometry, meshSection, vertices, indices, uvs, colors, darkColors, lastMaterial);
-			lastMaterial = material;
-			idx = 0;
+		const int32 firstIndex = batch->indices.Num();
+		batch->indices.AddUninitialized(Mesh.numIndices);
+		SlateIndex *indexData = batch->indices.GetData() + firstIndex;
+		for (int j = 0; j < Mesh.numIndices; j++) {
+			indexData[j] = (SlateIndex) (firstVertex + Mesh.indices[j]);
 		}
-
-		uint8 r = static_cast<uint8>(Skeleton->getColor().r * slot->getColor().r * attachmentColor.r * 255);
-		uint8 g = static_cast<uint8>(Skeleton->getColor().g * slot->getColor().g * attachmentColor.g * 255);
-		uint8 b = static_cast<uint8>(Skeleton->getColor().b * slot->getColor().b * attachmentColor.b * 255);
-		uint8 a = static_cast<uint8>(Skeleton->getColor().a * slot->getColor().a * attachmentColor.a * 255);
-
-		float dr = slot->hasDarkColor() ? slot->getDarkColor().r : 0.0f;
-		float dg = slot->hasDarkColor() ? slot->getDarkColor().g : 0.0f;
-		float db = slot->hasDarkColor() ? slot->getDarkColor().b : 0.0f;
-
-		float *verticesPtr = attachmentVertices->buffer();
-		for (int j = 0; j < numVertices << 1; j += 2) {
-			colors.Add(FColor(r, g, b, a));
-			darkColors.Add(FVector(dr, dg, db));
-			vertices.Add(FVector(verticesPtr[j], -verticesPtr[j + 1], depthOffset));
-			uvs.Add(FVector2D(attachmentUvs[j], attachmentUvs[j + 1]));
-		}
-
-		for (int j = 0; j < numIndices; j++) {
-			indices.Add(idx + attachmentIndices[j]);
-		}
-
-		idx += numVertices;
-		depthOffset += widget->DepthOffset;
-
-		clipper.clipEnd(*slot);
-	}
-
-	Flush(LayerId, OutDrawElements, AllottedGeometry, meshSection, vertices, indices, uvs, colors, darkColors, lastMaterial);
-	clipper.clipEnd();
+	});
 }
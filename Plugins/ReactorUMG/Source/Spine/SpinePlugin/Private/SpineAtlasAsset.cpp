@@ -28,6 +28,7 @@
  *****************************************************************************/
 
 #include "SpineAtlasAsset.h"
+#include "SpineSkeletonDataAsset.h"
 #include "spine/spine.h"
 #include <string.h>
 #include <string>
@@ -80,19 +81,22 @@ FName USpineAtlasAsset::GetAtlasFileName() const {
 #endif
 }
 
-void USpineAtlasAsset::SetRawData(const FString &RawData) {
-	this->rawData = RawData;
+void USpineAtlasAsset::ClearAtlas() {
 	if (atlas) {
+		// skeleton data parsed against the atlas points into its regions
+		USpineSkeletonDataAsset::ReleaseNativeData(atlas);
 		delete atlas;
 		atlas = nullptr;
 	}
 }
 
+void USpineAtlasAsset::SetRawData(const FString &RawData) {
+	this->rawData = RawData;
+	ClearAtlas();
+}
+
 void USpineAtlasAsset::BeginDestroy() {
-	if (atlas) {
-		delete atlas;
-		atlas = nullptr;
-	}
+	ClearAtlas();
 	Super::BeginDestroy();
 }
 
@@ -107,16 +111,21 @@ class UETextureLoader : public TextureLoader {
 
 UETextureLoader _spineUETextureLoader;
 
+Atlas *USpineAtlasAsset::ParseAtlas(const FString &RawData) {
+	std::string t = TCHAR_TO_UTF8(*RawData);
+
+	return new (__FILE__, __LINE__)
+			Atlas(t.c_str(), strlen(t.c_str()), "", &_spineUETextureLoader);
+}
+
+void USpineAtlasAsset::SetParsedAtlas(const FString &RawData, Atlas *ParsedAtlas) {
+	SetRawData(RawData);
+	atlas = ParsedAtlas;
+}
+
 Atlas *USpineAtlasAsset::GetAtlas() {
 	if (!atlas) {
-		if (atlas) {
-			delete atlas;
-			atlas = nullptr;
-		}
-		std::string t = TCHAR_TO_UTF8(*rawData);
-
-		atlas = new (__FILE__, __LINE__)
-				Atlas(t.c_str(), strlen(t.c_str()), "", &_spineUETextureLoader);
+		atlas = ParseAtlas(rawData);
 	}
 	return this->atlas;
 }
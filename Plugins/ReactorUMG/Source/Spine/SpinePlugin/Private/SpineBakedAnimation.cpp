@@ -0,0 +1,169 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "SpineBakedAnimation.h"
+#include "SpineSlotMesh.h"
+#include "Async/Async.h"
+
+using namespace spine;
+
+// bounds the memory of long animations, their frame rate is lowered instead
+static constexpr int32 MaxBakedFrames = 600;
+
+int32 FSpineBakedAnimation::GetFrameIndex(float Time) const {
+	if (duration <= 0 || frames.Num() <= 1) return 0;
+	const float loopTime = FMath::Fmod(Time, duration);
+	return FMath::Clamp(FMath::FloorToInt((loopTime < 0 ? loopTime + duration : loopTime) * frameRate), 0, frames.Num() - 1);
+}
+
+FSpineBakedAnimationCache &FSpineBakedAnimationCache::Get() {
+	static FSpineBakedAnimationCache Instance;
+	return Instance;
+}
+
+TSharedPtr<const FSpineBakedAnimation> FSpineBakedAnimationCache::FindOrBake(SkeletonData *Data, Skin *Skin, Animation *Animation, float FrameRate) {
+	check(IsInGameThread());
+	if (!Data || !Animation || FrameRate <= 0) return nullptr;
+
+	ReleaseFinishedBakes();
+
+	if (Skin && !Data->getSkins().contains(Skin)) {
+		// the widget deletes its combined skin when the skins change, the worker samples a copy instead
+		spine::Skin *skinCopy = new spine::Skin(Skin->getName());
+		skinCopy->addSkin(Skin);
+		return StartBake(Data, skinCopy, skinCopy, Animation, FrameRate);
+	}
+
+	const FKey key(Data, Skin, Animation, FMath::RoundToInt(FrameRate * 1000));
+	if (TWeakPtr<const FSpineBakedAnimation> *existing = bakes.Find(key)) {
+		if (TSharedPtr<const FSpineBakedAnimation> baked = existing->Pin()) return baked;
+	}
+
+	for (auto it = bakes.CreateIterator(); it; ++it) {
+		if (!it.Value().IsValid()) it.RemoveCurrent();
+	}
+
+	TSharedRef<const FSpineBakedAnimation> baked = StartBake(Data, Skin, nullptr, Animation, FrameRate);
+	bakes.Add(key, baked);
+	return baked;
+}
+
+void FSpineBakedAnimationCache::Flush(SkeletonData *Data) {
+	check(IsInGameThread());
+	for (FPendingBake &bake : pending) {
+		if (bake.data == Data) bake.task.Wait();
+	}
+	ReleaseFinishedBakes();
+
+	for (auto it = bakes.CreateIterator(); it; ++it) {
+		if (it.Key().Get<0>() == Data) it.RemoveCurrent();
+	}
+}
+
+TSharedRef<const FSpineBakedAnimation> FSpineBakedAnimationCache::StartBake(SkeletonData *Data, Skin *Skin, spine::Skin *OwnedSkin, Animation *Animation, float FrameRate) {
+	TSharedRef<FSpineBakedAnimation> baked = MakeShared<FSpineBakedAnimation>();
+	baked->duration = Animation->getDuration();
+	const int32 numFrames = FMath::Clamp(FMath::CeilToInt(baked->duration * FrameRate), 1, MaxBakedFrames);
+	baked->frameRate = baked->duration > 0 ? numFrames / baked->duration : FrameRate;
+	baked->frames.SetNum(numFrames);
+
+	// sampling hundreds of frames would stall the game thread, widgets keep evaluating the skeleton meanwhile
+	FPendingBake &bake = pending.AddDefaulted_GetRef();
+	bake.data = Data;
+	bake.ownedSkin = OwnedSkin;
+	bake.task = Async(EAsyncExecution::ThreadPool, [baked, Data, Skin, Animation]() {
+		Bake(*baked, Data, Skin, Animation);
+		baked->ready.store(true, std::memory_order_release);
+	});
+	return baked;
+}
+
+void FSpineBakedAnimationCache::ReleaseFinishedBakes() {
+	// skins are deleted here rather than on the worker, attachment reference counts are not thread safe
+	for (int32 i = pending.Num() - 1; i >= 0; i--) {
+		if (!pending[i].task.IsReady()) continue;
+		delete pending[i].ownedSkin;
+		pending.RemoveAtSwap(i);
+	}
+}
+
+void FSpineBakedAnimationCache::Bake(FSpineBakedAnimation &Baked, SkeletonData *Data, Skin *Skin, Animation *Animation) {
+	Skeleton skeleton(Data);
+	if (Skin) skeleton.setSkin(Skin);
+	SkeletonClipping clipper;
+	Vector<float> worldVertices;
+	worldVertices.ensureCapacity(1024 * 2);
+
+	for (int32 i = 0; i < Baked.frames.Num(); i++) {
+		const float time = i / Baked.frameRate;
+		skeleton.setToSetupPose();
+		Animation->apply(skeleton, time, time, true, nullptr, 1, MixBlend_Setup, MixDirection_In);
+		skeleton.updateWorldTransform(Physics_None);
+		BakeFrame(skeleton, clipper, worldVertices, Baked.frames[i]);
+	}
+}
+
+void FSpineBakedAnimationCache::BakeFrame(Skeleton &Skeleton, SkeletonClipping &Clipper, Vector<float> &WorldVertices, FSpineBakedAnimation::FFrame &Frame) {
+	FSpineBakedAnimation::FSection *section = nullptr;
+
+	ForEachSpineSlotMesh(Skeleton, Clipper, WorldVertices, [&](const FSpineSlotMesh &Mesh) {
+		const BlendMode blendMode = Mesh.slot->getData().getBlendMode();
+		if (!section || section->page != Mesh.region->page || section->blendMode != blendMode) {
+			section = &Frame.sections.AddDefaulted_GetRef();
+			section->page = Mesh.region->page;
+			section->blendMode = blendMode;
+			section->firstVertex = Frame.positions.Num();
+			section->numVertices = 0;
+			section->firstIndex = Frame.indices.Num();
+			section->numIndices = 0;
+		}
+
+		const Color &slotColor = Mesh.slot->getColor();
+		const Color &attachmentColor = Mesh.attachmentColor;
+		const FColor color(static_cast<uint8>(slotColor.r * attachmentColor.r * 255), static_cast<uint8>(slotColor.g * attachmentColor.g * 255),
+						   static_cast<uint8>(slotColor.b * attachmentColor.b * 255), static_cast<uint8>(slotColor.a * attachmentColor.a * 255));
+
+		for (int j = 0; j < Mesh.numVertices; j++) {
+			Frame.positions.Add(FVector2f(Mesh.vertices[j << 1], -Mesh.vertices[(j << 1) + 1]));
+			Frame.uvs.Add(FVector2f(Mesh.uvs[j << 1], Mesh.uvs[(j << 1) + 1]));
+			Frame.colors.Add(color);
+		}
+		for (int j = 0; j < Mesh.numIndices; j++) {
+			Frame.indices.Add((SlateIndex) (section->numVertices + Mesh.indices[j]));
+		}
+		section->numVertices += Mesh.numVertices;
+		section->numIndices += Mesh.numIndices;
+	});
+
+	Frame.positions.Shrink();
+	Frame.uvs.Shrink();
+	Frame.colors.Shrink();
+	Frame.indices.Shrink();
+	Frame.sections.Shrink();
+}
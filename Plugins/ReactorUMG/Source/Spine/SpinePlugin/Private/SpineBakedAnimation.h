@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Rendering/RenderingCommon.h"
+#include <spine/spine.h>
+#include <atomic>
+
+// A looping animation sampled at a fixed rate into ready to draw meshes. Playing it back only copies the
+// vertices of the current frame, neither the animation state nor the skeleton is evaluated.
+// Frames are sampled from the setup pose of the skin, mixing, physics, events and runtime changes to slots or
+// attachments are not part of them.
+struct FSpineBakedAnimation {
+	// consecutive slots drawn with the same atlas page and blend mode
+	struct FSection {
+		spine::AtlasPage *page;
+		spine::BlendMode blendMode;
+		int32 firstVertex;
+		int32 numVertices;
+		int32 firstIndex;
+		int32 numIndices;
+	};
+
+	struct FFrame {
+		TArray<FSection> sections;
+		// skeleton space with y pointing down, as SSpineWidget keeps them
+		TArray<FVector2f> positions;
+		TArray<FVector2f> uvs;
+		// slot times attachment color, the widget color is applied when drawing
+		TArray<FColor> colors;
+		// relative to the first vertex of their section
+		TArray<SlateIndex> indices;
+	};
+
+	float frameRate = 0;
+	float duration = 0;
+	TArray<FFrame> frames;
+
+	int32 GetFrameIndex(float Time) const;
+
+	// frames are filled on a worker, only frameRate and duration may be read before this returns true
+	bool IsReady() const { return ready.load(std::memory_order_acquire); }
+
+	std::atomic<bool> ready{false};
+};
+
+// Bakes every animation once per skeleton data, skin, animation and frame rate and shares it between all widgets
+// playing it. Bakes are released with the last widget using them. Frames are sampled on a worker, the cache
+// itself is game thread only.
+class FSpineBakedAnimationCache {
+public:
+	static FSpineBakedAnimationCache &Get();
+
+	// Skin may be nullptr, skins not owned by the skeleton data (combined skins) are baked for the caller only.
+	// Returns before the frames are sampled, the bake can be drawn once IsReady().
+	TSharedPtr<const FSpineBakedAnimation> FindOrBake(spine::SkeletonData *Data, spine::Skin *Skin, spine::Animation *Animation, float FrameRate);
+
+	// Waits for the workers still sampling Data and forgets its bakes, a new skeleton data allocated at the same
+	// address must not find them. Call before Data is deleted.
+	void Flush(spine::SkeletonData *Data);
+
+private:
+	// OwnedSkin is deleted once the worker is done with it
+	TSharedRef<const FSpineBakedAnimation> StartBake(spine::SkeletonData *Data, spine::Skin *Skin, spine::Skin *OwnedSkin, spine::Animation *Animation, float FrameRate);
+
+	void ReleaseFinishedBakes();
+
+	static void Bake(FSpineBakedAnimation &Baked, spine::SkeletonData *Data, spine::Skin *Skin, spine::Animation *Animation);
+
+	static void BakeFrame(spine::Skeleton &Skeleton, spine::SkeletonClipping &Clipper, spine::Vector<float> &WorldVertices, FSpineBakedAnimation::FFrame &Frame);
+
+	using FKey = TTuple<spine::SkeletonData *, spine::Skin *, spine::Animation *, int32>;
+	TMap<FKey, TWeakPtr<const FSpineBakedAnimation>> bakes;
+
+	struct FPendingBake {
+		spine::SkeletonData *data;
+		spine::Skin *ownedSkin;
+		TFuture<void> task;
+	};
+	TArray<FPendingBake> pending;
+};
@@ -28,7 +28,11 @@
  *****************************************************************************/
 
 #include "SpinePlugin.h"
+#include "Containers/LockFreeFixedSizeAllocator.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
 #include "spine/Extension.h"
+#include <atomic>
 
 DEFINE_LOG_CATEGORY(SpineLog);
 
@@ -44,6 +48,10 @@ void FSpinePlugin::StartupModule() {
 
 void FSpinePlugin::ShutdownModule() {}
 
+// Small blocks come from size class pools with thread local caches instead of the general heap. Skeletons, track
+// entries and clipping vectors are created and destroyed in bursts on screen transitions, and in parallel when
+// Spine.ParallelWidgetUpdate is on, recycling same sized blocks keeps that off the global allocator.
+// Every block starts with a header naming its size class, as spine frees without passing the size.
 class Ue4Extension : public spine::DefaultSpineExtension {
 public:
 	Ue4Extension() : spine::DefaultSpineExtension() {}
@@ -51,24 +59,181 @@ public:
 	virtual ~Ue4Extension() {}
 
 	virtual void *_alloc(size_t size, const char *file, int line) {
-		return FMemory::Malloc(size);
+		const int32 sizeClass = GetSizeClass(size);
+		FThreadStats &stats = GetThreadStats();
+		FBlockHeader *header;
+		if (sizeClass == LargeSizeClass) {
+			header = static_cast<FBlockHeader *>(FMemory::Malloc(sizeof(FBlockHeader) + size));
+			AddStat(stats.numLargeAllocations, 1);
+		} else {
+			header = static_cast<FBlockHeader *>(AllocateBlock(sizeClass));
+			AddStat(stats.numPooledAllocations, 1);
+		}
+		header->sizeClass = sizeClass;
+		header->size = size;
+		AddStat(stats.allocatedBytes, size);
+		AddStat(stats.totalAllocations, 1);
+		return header + 1;
 	}
 
 	virtual void *_calloc(size_t size, const char *file, int line) {
-		void *result = FMemory::Malloc(size);
+		void *result = _alloc(size, file, line);
 		FMemory::Memset(result, 0, size);
 		return result;
 	}
 
 	virtual void *_realloc(void *ptr, size_t size, const char *file, int line) {
-		return FMemory::Realloc(ptr, size);
+		if (!ptr) return _alloc(size, file, line);
+
+		FBlockHeader *header = static_cast<FBlockHeader *>(ptr) - 1;
+		if (header->sizeClass != LargeSizeClass && GetSizeClass(size) == header->sizeClass) {
+			AddStat(GetThreadStats().allocatedBytes, static_cast<int64>(size) - static_cast<int64>(header->size));
+			header->size = size;
+			return ptr;
+		}
+
+		void *result = _alloc(size, file, line);
+		FMemory::Memcpy(result, ptr, FMath::Min<size_t>(size, header->size));
+		_free(ptr, file, line);
+		return result;
 	}
 
 	virtual void _free(void *mem, const char *file, int line) {
-		FMemory::Free(mem);
+		if (!mem) return;
+
+		FBlockHeader *header = static_cast<FBlockHeader *>(mem) - 1;
+		FThreadStats &stats = GetThreadStats();
+		AddStat(stats.allocatedBytes, -static_cast<int64>(header->size));
+		if (header->sizeClass == LargeSizeClass) {
+			AddStat(stats.numLargeAllocations, -1);
+			FMemory::Free(header);
+		} else {
+			AddStat(stats.numPooledAllocations, -1);
+			FreeBlock(header->sizeClass, header);
+		}
+	}
+
+	void DumpStats() const {
+		int64 allocatedBytes = 0, numPooledAllocations = 0, numLargeAllocations = 0, totalAllocations = 0;
+		{
+			FScopeLock lock(&threadStatsLock);
+			for (const FThreadStats *stats : threadStats) {
+				allocatedBytes += stats->allocatedBytes.load(std::memory_order_relaxed);
+				numPooledAllocations += stats->numPooledAllocations.load(std::memory_order_relaxed);
+				numLargeAllocations += stats->numLargeAllocations.load(std::memory_order_relaxed);
+				totalAllocations += stats->totalAllocations.load(std::memory_order_relaxed);
+			}
+		}
+		UE_LOG(SpineLog, Display, TEXT("Spine memory: %lld bytes in use, %lld pooled and %lld heap blocks, %lld allocations in total"),
+			   allocatedBytes, numPooledAllocations, numLargeAllocations, totalAllocations);
+	}
+
+private:
+	// keeps the memory after it 16 byte aligned
+	struct alignas(16) FBlockHeader {
+		int32 sizeClass;
+		size_t size;
+	};
+
+	template<int32 BlockSize>
+	using TBlockPool = TLockFreeFixedSizeAllocator_TLSCache<BlockSize, PLATFORM_CACHE_LINE_SIZE>;
+
+	// blocks of 32 to 1024 bytes including the header, larger ones go to the heap
+	static constexpr int32 NumSizeClasses = 6;
+	static constexpr int32 LargeSizeClass = NumSizeClasses;
+
+	static int32 GetSizeClass(size_t size) {
+		const size_t blockSize = size + sizeof(FBlockHeader);
+		if (blockSize > (32 << (NumSizeClasses - 1))) return LargeSizeClass;
+		return blockSize <= 32 ? 0 : static_cast<int32>(FMath::CeilLogTwo64(blockSize)) - 5;
+	}
+
+	void *AllocateBlock(int32 sizeClass) {
+		switch (sizeClass) {
+			case 0:
+				return pool32.Allocate();
+			case 1:
+				return pool64.Allocate();
+			case 2:
+				return pool128.Allocate();
+			case 3:
+				return pool256.Allocate();
+			case 4:
+				return pool512.Allocate();
+			default:
+				return pool1024.Allocate();
+		}
+	}
+
+	void FreeBlock(int32 sizeClass, void *block) {
+		switch (sizeClass) {
+			case 0:
+				pool32.Free(block);
+				break;
+			case 1:
+				pool64.Free(block);
+				break;
+			case 2:
+				pool128.Free(block);
+				break;
+			case 3:
+				pool256.Free(block);
+				break;
+			case 4:
+				pool512.Free(block);
+				break;
+			default:
+				pool1024.Free(block);
+		}
+	}
+
+	TBlockPool<32> pool32;
+	TBlockPool<64> pool64;
+	TBlockPool<128> pool128;
+	TBlockPool<256> pool256;
+	TBlockPool<512> pool512;
+	TBlockPool<1024> pool1024;
+
+	// counted per thread so the parallel widget update doesn't contend on shared counters, DumpStats sums them up.
+	// a block freed on another thread than it was allocated on can take a single thread below zero, the sum stays right
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FThreadStats {
+		std::atomic<int64> allocatedBytes{0};
+		std::atomic<int64> numPooledAllocations{0};
+		std::atomic<int64> numLargeAllocations{0};
+		std::atomic<int64> totalAllocations{0};
+	};
+
+	// only the owning thread writes its counters, so no read-modify-write is needed
+	static void AddStat(std::atomic<int64> &stat, int64 value) {
+		stat.store(stat.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+	}
+
+	FThreadStats &GetThreadStats() {
+		// never freed, blocks allocated by a thread may still be freed after it exited
+		static thread_local FThreadStats *currentThreadStats = nullptr;
+		if (!currentThreadStats) {
+			currentThreadStats = new FThreadStats();
+			FScopeLock lock(&threadStatsLock);
+			threadStats.Add(currentThreadStats);
+		}
+		return *currentThreadStats;
 	}
+
+	mutable FCriticalSection threadStatsLock;
+	TArray<FThreadStats *> threadStats;
 };
 
+// the extension is never destroyed, spine objects may still be freed during static destruction
+static Ue4Extension *ue4Extension = nullptr;
+
+static FAutoConsoleCommand SpineMemoryStatsCommand(
+		TEXT("Spine.MemoryStats"),
+		TEXT("Logs the memory currently allocated by the spine runtime."),
+		FConsoleCommandDelegate::CreateLambda([]() {
+			if (ue4Extension) ue4Extension->DumpStats();
+		}));
+
 spine::SpineExtension *spine::getDefaultExtension() {
-	return new Ue4Extension();
+	ue4Extension = new Ue4Extension();
+	return ue4Extension;
 }
@@ -30,6 +30,7 @@
 #include "SpineSkeletonDataAsset.h"
 #include "EditorFramework/AssetImportData.h"
 #include "Runtime/Core/Public/Misc/MessageDialog.h"
+#include "SpineBakedAnimation.h"
 #include "SpinePlugin.h"
 #include "spine/Version.h"
 #include "spine/spine.h"
@@ -39,6 +40,14 @@
 
 using namespace spine;
 
+namespace {
+	// the skeleton data assets holding native data parsed against each atlas, game thread only
+	TMap<Atlas *, TArray<USpineSkeletonDataAsset *>> &GetAtlasUsers() {
+		static TMap<Atlas *, TArray<USpineSkeletonDataAsset *>> atlasUsers;
+		return atlasUsers;
+	}
+}// namespace
+
 FName USpineSkeletonDataAsset::GetSkeletonDataFileName() const {
 #if WITH_EDITORONLY_DATA
 	TArray<FString> files;
@@ -94,16 +103,52 @@ void USpineSkeletonDataAsset::Serialize(FArchive &Ar) {
 
 #endif
 
+void USpineSkeletonDataAsset::AddNativeData(Atlas *Atlas, SkeletonData *SkeletonData) {
+	AnimationStateData *animationStateData =
+			new (__FILE__, __LINE__) AnimationStateData(SkeletonData);
+	SetMixes(animationStateData);
+	atlasToNativeData.Add(Atlas, {SkeletonData, animationStateData});
+	GetAtlasUsers().FindOrAdd(Atlas).AddUnique(this);
+}
+
 void USpineSkeletonDataAsset::ClearNativeData() {
+	TMap<Atlas *, TArray<USpineSkeletonDataAsset *>> &atlasUsers = GetAtlasUsers();
 	for (auto &pair : atlasToNativeData) {
-		if (pair.Value.skeletonData)
+		if (pair.Value.skeletonData) {
+			FSpineBakedAnimationCache::Get().Flush(pair.Value.skeletonData);
 			delete pair.Value.skeletonData;
+		}
 		if (pair.Value.animationStateData)
 			delete pair.Value.animationStateData;
+		if (TArray<USpineSkeletonDataAsset *> *users = atlasUsers.Find(pair.Key)) {
+			users->Remove(this);
+			if (users->Num() == 0) atlasUsers.Remove(pair.Key);
+		}
 	}
 	atlasToNativeData.Empty();
 }
 
+void USpineSkeletonDataAsset::ClearNativeData(Atlas *Atlas) {
+	NativeSkeletonData nativeData;
+	if (atlasToNativeData.RemoveAndCopyValue(Atlas, nativeData)) {
+		if (nativeData.skeletonData) {
+			FSpineBakedAnimationCache::Get().Flush(nativeData.skeletonData);
+			delete nativeData.skeletonData;
+		}
+		if (nativeData.animationStateData)
+			delete nativeData.animationStateData;
+	}
+}
+
+void USpineSkeletonDataAsset::ReleaseNativeData(Atlas *Atlas) {
+	TArray<USpineSkeletonDataAsset *> users;
+	if (GetAtlasUsers().RemoveAndCopyValue(Atlas, users)) {
+		for (USpineSkeletonDataAsset *user : users) {
+			user->ClearNativeData(Atlas);
+		}
+	}
+}
+
 void USpineSkeletonDataAsset::BeginDestroy() {
 	ClearNativeData();
 
@@ -270,34 +315,77 @@ void USpineSkeletonDataAsset::LoadInfo() {
 		delete binary;
 	}
 	if (skeletonData) {
-		Bones.Empty();
-		for (int i = 0; i < skeletonData->getBones().size(); i++)
-			Bones.Add(UTF8_TO_TCHAR(skeletonData->getBones()[i]->getName().buffer()));
-		Skins.Empty();
-		for (int i = 0; i < skeletonData->getSkins().size(); i++)
-			Skins.Add(UTF8_TO_TCHAR(skeletonData->getSkins()[i]->getName().buffer()));
-		Slots.Empty();
-		for (int i = 0; i < skeletonData->getSlots().size(); i++)
-			Slots.Add(UTF8_TO_TCHAR(skeletonData->getSlots()[i]->getName().buffer()));
-		Animations.Empty();
-		for (int i = 0; i < skeletonData->getAnimations().size(); i++)
-			Animations.Add(
-					UTF8_TO_TCHAR(skeletonData->getAnimations()[i]->getName().buffer()));
-		Events.Empty();
-		for (int i = 0; i < skeletonData->getEvents().size(); i++)
-			Events.Add(
-					UTF8_TO_TCHAR(skeletonData->getEvents()[i]->getName().buffer()));
+		SetInfo(skeletonData);
 		delete skeletonData;
 	}
 #endif
 }
 
+void USpineSkeletonDataAsset::SetInfo(SkeletonData *skeletonData) {
+	Bones.Empty();
+	for (int i = 0; i < skeletonData->getBones().size(); i++)
+		Bones.Add(UTF8_TO_TCHAR(skeletonData->getBones()[i]->getName().buffer()));
+	Skins.Empty();
+	for (int i = 0; i < skeletonData->getSkins().size(); i++)
+		Skins.Add(UTF8_TO_TCHAR(skeletonData->getSkins()[i]->getName().buffer()));
+	Slots.Empty();
+	for (int i = 0; i < skeletonData->getSlots().size(); i++)
+		Slots.Add(UTF8_TO_TCHAR(skeletonData->getSlots()[i]->getName().buffer()));
+	Animations.Empty();
+	for (int i = 0; i < skeletonData->getAnimations().size(); i++)
+		Animations.Add(
+				UTF8_TO_TCHAR(skeletonData->getAnimations()[i]->getName().buffer()));
+	Events.Empty();
+	for (int i = 0; i < skeletonData->getEvents().size(); i++)
+		Events.Add(
+				UTF8_TO_TCHAR(skeletonData->getEvents()[i]->getName().buffer()));
+}
+
+SkeletonData *USpineSkeletonDataAsset::ParseSkeletonData(const TArray<uint8> &Data, bool bIsJson,
+														 Atlas *Atlas, FString &OutError) {
+	SkeletonData *skeletonData = nullptr;
+	if (bIsJson) {
+		SkeletonJson *json = new (__FILE__, __LINE__) SkeletonJson(Atlas);
+		if (checkJson((const char *) Data.GetData()))
+			skeletonData = json->readSkeletonData((const char *) Data.GetData());
+		if (!skeletonData)
+			OutError = UTF8_TO_TCHAR(json->getError().buffer());
+		delete json;
+	} else {
+		SkeletonBinary *binary = new (__FILE__, __LINE__) SkeletonBinary(Atlas);
+		if (checkBinary((const char *) Data.GetData(), (int) Data.Num()))
+			skeletonData = binary->readSkeletonData(
+					(const unsigned char *) Data.GetData(), (int) Data.Num());
+		if (!skeletonData)
+			OutError = UTF8_TO_TCHAR(binary->getError().buffer());
+		delete binary;
+	}
+	return skeletonData;
+}
+
+void USpineSkeletonDataAsset::SetParsedSkeletonData(TArray<uint8> &Data, const FName &FileName,
+													Atlas *Atlas, SkeletonData *ParsedSkeletonData) {
+	this->rawData.Empty();
+	this->rawData.Append(Data);
+#if WITH_EDITORONLY_DATA
+	if (importData)
+		SetSkeletonDataFileName(FileName);
+	else
+		skeletonDataFileName = FileName;
+#else
+	skeletonDataFileName = FileName;
+#endif
+
+	ClearNativeData();
+
+	SetInfo(ParsedSkeletonData);
+	AddNativeData(Atlas, ParsedSkeletonData);
+}
+
 SkeletonData *USpineSkeletonDataAsset::GetSkeletonData(Atlas *Atlas) {
 	SkeletonData *skeletonData = nullptr;
-	AnimationStateData *animationStateData = nullptr;
 	if (atlasToNativeData.Contains(Atlas)) {
 		skeletonData = atlasToNativeData[Atlas].skeletonData;
-		animationStateData = atlasToNativeData[Atlas].animationStateData;
 	}
 
 	if (!skeletonData) {
@@ -342,10 +430,7 @@ SkeletonData *USpineSkeletonDataAsset::GetSkeletonData(Atlas *Atlas) {
 		}
 
 		if (skeletonData) {
-			animationStateData =
-					new (__FILE__, __LINE__) AnimationStateData(skeletonData);
-			SetMixes(animationStateData);
-			atlasToNativeData.Add(Atlas, {skeletonData, animationStateData});
+			AddNativeData(Atlas, skeletonData);
 		}
 	}
 
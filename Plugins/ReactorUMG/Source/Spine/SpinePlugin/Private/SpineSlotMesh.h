@@ -0,0 +1,121 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <spine/spine.h>
+
+// One visible region or mesh attachment of a slot, already clipped. Vertices are in skeleton space, indices are
+// relative to the first vertex.
+struct FSpineSlotMesh {
+	spine::Slot *slot;
+	spine::AtlasRegion *region;
+	spine::Color attachmentColor;
+	float *vertices;
+	float *uvs;
+	unsigned short *indices;
+	int numVertices;
+	int numIndices;
+};
+
+// Walks the draw order of a skeleton and calls Visitor for every slot mesh to draw, shared by the live and the baked
+// widget meshes. Inactive bones, other attachment types and attachments without region are skipped, clipping
+// attachments clip the slots after them.
+template<typename VisitorType>
+void ForEachSpineSlotMesh(spine::Skeleton &Skeleton, spine::SkeletonClipping &Clipper, spine::Vector<float> &WorldVertices, VisitorType &&Visitor) {
+	using namespace spine;
+
+	static unsigned short quadIndices[] = {0, 1, 2, 0, 2, 3};
+
+	for (int i = 0; i < (int) Skeleton.getSlots().size(); ++i) {
+		Slot *slot = Skeleton.getDrawOrder()[i];
+		Attachment *attachment = slot->getAttachment();
+		if (!slot->getBone().isActive() || !attachment) {
+			Clipper.clipEnd(*slot);
+			continue;
+		}
+
+		FSpineSlotMesh mesh;
+		mesh.slot = slot;
+		mesh.attachmentColor.set(1, 1, 1, 1);
+		if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+			RegionAttachment *regionAttachment = (RegionAttachment *) attachment;
+			mesh.attachmentColor.set(regionAttachment->getColor());
+			WorldVertices.setSize(8, 0);
+			regionAttachment->computeWorldVertices(*slot, WorldVertices, 0, 2);
+			mesh.region = (AtlasRegion *) regionAttachment->getRegion();
+			mesh.indices = quadIndices;
+			mesh.uvs = regionAttachment->getUVs().buffer();
+			mesh.numVertices = 4;
+			mesh.numIndices = 6;
+		} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+			MeshAttachment *meshAttachment = (MeshAttachment *) attachment;
+			mesh.attachmentColor.set(meshAttachment->getColor());
+			WorldVertices.setSize(meshAttachment->getWorldVerticesLength(), 0);
+			meshAttachment->computeWorldVertices(*slot, 0, meshAttachment->getWorldVerticesLength(), WorldVertices.buffer(), 0, 2);
+			mesh.region = (AtlasRegion *) meshAttachment->getRegion();
+			mesh.indices = meshAttachment->getTriangles().buffer();
+			mesh.uvs = meshAttachment->getUVs().buffer();
+			mesh.numVertices = meshAttachment->getWorldVerticesLength() >> 1;
+			mesh.numIndices = meshAttachment->getTriangles().size();
+		} else if (attachment->getRTTI().isExactly(ClippingAttachment::rtti)) {
+			Clipper.clipStart(*slot, (ClippingAttachment *) attachment);
+			continue;
+		} else {
+			Clipper.clipEnd(*slot);
+			continue;
+		}
+		mesh.vertices = WorldVertices.buffer();
+
+		if (!mesh.region) {
+			Clipper.clipEnd(*slot);
+			continue;
+		}
+
+		if (Clipper.isClipping()) {
+			Clipper.clipTriangles(WorldVertices.buffer(), mesh.indices, mesh.numIndices, mesh.uvs, 2);
+			mesh.vertices = Clipper.getClippedVertices().buffer();
+			mesh.numVertices = Clipper.getClippedVertices().size() >> 1;
+			mesh.indices = Clipper.getClippedTriangles().buffer();
+			mesh.numIndices = Clipper.getClippedTriangles().size();
+			mesh.uvs = Clipper.getClippedUVs().buffer();
+			if (mesh.numIndices == 0) {
+				Clipper.clipEnd(*slot);
+				continue;
+			}
+		}
+
+		Visitor(mesh);
+
+		Clipper.clipEnd(*slot);
+	}
+
+	Clipper.clipEnd();
+}
@@ -29,6 +29,7 @@
 
 #include "SpineWidget.h"
 #include "SSpineWidget.h"
+#include "SpineBakedAnimation.h"
 #include "SpineSkeletonAnimationComponent.h"
 #include "spine/spine.h"
 
@@ -41,32 +42,42 @@ void callbackWidget(AnimationState *state, spine::EventType type, TrackEntry *en
 
 	if (entry->getRendererObject()) {
 		UTrackEntry *uEntry = (UTrackEntry *) entry->getRendererObject();
-		if (type == EventType_Start) {
-			component->AnimationStart.Broadcast(uEntry);
-			uEntry->AnimationStart.Broadcast(uEntry);
-		} else if (type == EventType_Interrupt) {
-			component->AnimationInterrupt.Broadcast(uEntry);
-			uEntry->AnimationInterrupt.Broadcast(uEntry);
-		} else if (type == EventType_Event) {
-			FSpineEvent evt;
-			evt.SetEvent(event);
-			component->AnimationEvent.Broadcast(uEntry, evt);
-			uEntry->AnimationEvent.Broadcast(uEntry, evt);
-		} else if (type == EventType_Complete) {
-			component->AnimationComplete.Broadcast(uEntry);
-			uEntry->AnimationComplete.Broadcast(uEntry);
-		} else if (type == EventType_End) {
-			component->AnimationEnd.Broadcast(uEntry);
-			uEntry->AnimationEnd.Broadcast(uEntry);
-		} else if (type == EventType_Dispose) {
-			component->AnimationDispose.Broadcast(uEntry);
-			uEntry->AnimationDispose.Broadcast(uEntry);
-			uEntry->SetTrackEntry(nullptr);
-			component->GCTrackEntry(uEntry);
+		FSpineEvent evt;
+		if (type == EventType_Event) evt.SetEvent(event);
+
+		if (component->bDeferAnimationEvents) {
+			// UObjects are only touched on the game thread, disposed entries are released in BroadcastDeferredAnimationEvents
+			component->deferredAnimationEvents.Add({type, uEntry, evt});
+		} else {
+			component->BroadcastAnimationEvent(type, uEntry, evt);
 		}
 	}
 }
 
+void USpineWidget::BroadcastAnimationEvent(spine::EventType type, UTrackEntry *uEntry, const FSpineEvent &evt) {
+	if (type == EventType_Start) {
+		AnimationStart.Broadcast(uEntry);
+		uEntry->AnimationStart.Broadcast(uEntry);
+	} else if (type == EventType_Interrupt) {
+		AnimationInterrupt.Broadcast(uEntry);
+		uEntry->AnimationInterrupt.Broadcast(uEntry);
+	} else if (type == EventType_Event) {
+		AnimationEvent.Broadcast(uEntry, evt);
+		uEntry->AnimationEvent.Broadcast(uEntry, evt);
+	} else if (type == EventType_Complete) {
+		AnimationComplete.Broadcast(uEntry);
+		uEntry->AnimationComplete.Broadcast(uEntry);
+	} else if (type == EventType_End) {
+		AnimationEnd.Broadcast(uEntry);
+		uEntry->AnimationEnd.Broadcast(uEntry);
+	} else if (type == EventType_Dispose) {
+		AnimationDispose.Broadcast(uEntry);
+		uEntry->AnimationDispose.Broadcast(uEntry);
+		uEntry->SetTrackEntry(nullptr);
+		GCTrackEntry(uEntry);
+	}
+}
+
 USpineWidget::USpineWidget(const FObjectInitializer &ObjectInitializer) : Super(ObjectInitializer) {
 	static ConstructorHelpers::FObjectFinder<UMaterialInterface> NormalMaterialRef(TEXT("/ReactorUMG/Spine/UI_SpineUnlitNormalMaterial"));
 	NormalBlendMaterial = NormalMaterialRef.Object;
@@ -132,6 +143,12 @@ const FText USpineWidget::GetPaletteCategory() {
 void USpineWidget::Tick(float DeltaTime, bool CallDelegates) {
 	CheckState();
 
+	// until its frames are sampled the skeleton keeps playing
+	if (bakedAnimation && bakedAnimation->IsReady()) {
+		UpdateBakedAnimation(bAutoPlaying ? DeltaTime : 0);
+		return;
+	}
+
 	if (state && bAutoPlaying) {
 		state->update(DeltaTime);
 		state->apply(*skeleton);
@@ -139,6 +156,47 @@ void USpineWidget::Tick(float DeltaTime, bool CallDelegates) {
 		skeleton->update(physicsTimeScale * DeltaTime);
 		skeleton->updateWorldTransform(Physics_Update);
 		if (CallDelegates) AfterUpdateWorldTransform.Broadcast(this);
+		// new tracks only show once applied, a mesh built before that still has the old pose
+		if (DeltaTime != 0 || bTracksChanged) {
+			poseVersion++;
+			bTracksChanged = false;
+		}
+	}
+}
+
+void USpineWidget::UpdateAnimation(float DeltaTime) {
+	bDeferAnimationEvents = true;
+	state->update(DeltaTime);
+	state->apply(*skeleton);
+	skeleton->update(physicsTimeScale * DeltaTime);
+	skeleton->updateWorldTransform(Physics_Update);
+	if (DeltaTime != 0 || bTracksChanged) {
+		poseVersion++;
+		bTracksChanged = false;
+	}
+	bDeferAnimationEvents = false;
+}
+
+void USpineWidget::UpdateBakedAnimation(float DeltaTime) {
+	bakedTime += DeltaTime * (state ? state->getTimeScale() : 1);
+	if (bakedAnimation->duration > 0) bakedTime = FMath::Fmod(bakedTime, bakedAnimation->duration);
+	const int32 frame = bakedAnimation->GetFrameIndex(bakedTime);
+	// the mesh is only rebuilt when the frame changes, not on every tick
+	if (frame != bakedFrame) {
+		bakedFrame = frame;
+		poseVersion++;
+	}
+}
+
+void USpineWidget::BroadcastDeferredAnimationEvents() {
+	// listeners may start new animations, which queue nothing until the next update
+	TArray<FDeferredAnimationEvent> events = MoveTemp(deferredAnimationEvents);
+	// the pooled entries may be reused by listeners starting animations, release them before any event goes out
+	for (const FDeferredAnimationEvent &deferredEvent : events) {
+		if (deferredEvent.type == EventType_Dispose) deferredEvent.entry->SetTrackEntry(nullptr);
+	}
+	for (const FDeferredAnimationEvent &deferredEvent : events) {
+		BroadcastAnimationEvent(deferredEvent.type, deferredEvent.entry, deferredEvent.event);
 	}
 }
 
@@ -177,6 +235,7 @@ void USpineWidget::CheckState() {
 			}
 		}
 
+		poseVersion++;
 		lastAtlas = Atlas;
 		lastSpineAtlas = Atlas ? Atlas->GetAtlas() : nullptr;
 		lastData = SkeletonData;
@@ -199,6 +258,9 @@ void USpineWidget::DisposeState() {
 		customSkin = nullptr;
 	}
 
+	// the bake points into the skeleton data and atlas being replaced
+	bakedAnimation.Reset();
+	bakedFrame = INDEX_NONE;
 	trackEntries.Empty();
 }
 
@@ -213,7 +275,9 @@ bool USpineWidget::SetSkin(const FString skinName) {
 		spine::Skin *skin = skeleton->getData()->findSkin(TCHAR_TO_UTF8(*skinName));
 		if (!skin) return false;
 		skeleton->setSkin(skin);
+		poseVersion++;
 		bSkinInitialized = true;
+		if (bakedAnimation) PlayBakedAnimation(bakedAnimationName, bakedAnimation->frameRate);
 		return true;
 	} else
 		return false;
@@ -232,11 +296,13 @@ bool USpineWidget::SetSkins(UPARAM(ref) TArray<FString> &SkinNames) {
 			newSkin->addSkin(skin);
 		}
 		skeleton->setSkin(newSkin);
+		poseVersion++;
 		bSkinInitialized = true;
 		if (customSkin != nullptr) {
 			delete customSkin;
 		}
 		customSkin = newSkin;
+		if (bakedAnimation) PlayBakedAnimation(bakedAnimationName, bakedAnimation->frameRate);
 		return true;
 	} else
 		return false;
@@ -264,10 +330,12 @@ bool USpineWidget::SetAttachment(const FString slotName, const FString attachmen
 	if (skeleton) {
 		if (attachmentName.IsEmpty()) {
 			skeleton->setAttachment(TCHAR_TO_UTF8(*slotName), NULL);
+			poseVersion++;
 			return true;
 		}
 		if (!skeleton->getAttachment(TCHAR_TO_UTF8(*slotName), TCHAR_TO_UTF8(*attachmentName))) return false;
 		skeleton->setAttachment(TCHAR_TO_UTF8(*slotName), TCHAR_TO_UTF8(*attachmentName));
+		poseVersion++;
 		return true;
 	}
 	return false;
@@ -277,27 +345,40 @@ void USpineWidget::UpdateWorldTransform() {
 	CheckState();
 	if (skeleton) {
 		skeleton->updateWorldTransform(Physics_Update);
+		poseVersion++;
 	}
 }
 
 void USpineWidget::SetToSetupPose() {
 	CheckState();
-	if (skeleton) skeleton->setToSetupPose();
+	if (skeleton) {
+		skeleton->setToSetupPose();
+		poseVersion++;
+	}
 }
 
 void USpineWidget::SetBonesToSetupPose() {
 	CheckState();
-	if (skeleton) skeleton->setBonesToSetupPose();
+	if (skeleton) {
+		skeleton->setBonesToSetupPose();
+		poseVersion++;
+	}
 }
 
 void USpineWidget::SetSlotsToSetupPose() {
 	CheckState();
-	if (skeleton) skeleton->setSlotsToSetupPose();
+	if (skeleton) {
+		skeleton->setSlotsToSetupPose();
+		poseVersion++;
+	}
 }
 
 void USpineWidget::SetScaleX(float scaleX) {
 	CheckState();
-	if (skeleton) skeleton->setScaleX(scaleX);
+	if (skeleton) {
+		skeleton->setScaleX(scaleX);
+		poseVersion++;
+	}
 }
 
 float USpineWidget::GetScaleX() {
@@ -308,7 +389,10 @@ float USpineWidget::GetScaleX() {
 
 void USpineWidget::SetScaleY(float scaleY) {
 	CheckState();
-	if (skeleton) skeleton->setScaleY(scaleY);
+	if (skeleton) {
+		skeleton->setScaleY(scaleY);
+		poseVersion++;
+	}
 }
 
 float USpineWidget::GetScaleY() {
@@ -376,6 +460,7 @@ void USpineWidget::SetSlotColor(const FString SlotName, const FColor SlotColor)
 		spine::Slot *slot = skeleton->findSlot(TCHAR_TO_UTF8(*SlotName));
 		if (slot) {
 			slot->getColor().set(SlotColor.R / 255.f, SlotColor.G / 255.f, SlotColor.B / 255.f, SlotColor.A / 255.f);
+			poseVersion++;
 		}
 	}
 }
@@ -431,6 +516,7 @@ void USpineWidget::SetPlaybackTime(float InPlaybackTime, bool bCallDelegates) {
 		if (bCallDelegates) {
 			AfterUpdateWorldTransform.Broadcast(this);
 		}
+		poseVersion++;
 	}
 }
 
@@ -448,9 +534,11 @@ float USpineWidget::GetTimeScale() {
 UTrackEntry *USpineWidget::SetAnimation(int trackIndex, FString animationName, bool loop) {
 	CheckState();
 	if (state && skeleton->getData()->findAnimation(TCHAR_TO_UTF8(*animationName))) {
+		StopBakedAnimation();
 		state->disableQueue();
 		TrackEntry *entry = state->setAnimation(trackIndex, TCHAR_TO_UTF8(*animationName), loop);
 		state->enableQueue();
+		bTracksChanged = true;
 		UTrackEntry *uEntry = NewObject<UTrackEntry>();
 		uEntry->SetTrackEntry(entry);
 		trackEntries.Add(uEntry);
@@ -465,6 +553,7 @@ UTrackEntry *USpineWidget::AddAnimation(int trackIndex, FString animationName, b
 		state->disableQueue();
 		TrackEntry *entry = state->addAnimation(trackIndex, TCHAR_TO_UTF8(*animationName), loop, delay);
 		state->enableQueue();
+		bTracksChanged = true;
 		UTrackEntry *uEntry = NewObject<UTrackEntry>();
 		uEntry->SetTrackEntry(entry);
 		trackEntries.Add(uEntry);
@@ -476,7 +565,9 @@ UTrackEntry *USpineWidget::AddAnimation(int trackIndex, FString animationName, b
 UTrackEntry *USpineWidget::SetEmptyAnimation(int trackIndex, float mixDuration) {
 	CheckState();
 	if (state) {
+		StopBakedAnimation();
 		TrackEntry *entry = state->setEmptyAnimation(trackIndex, mixDuration);
+		bTracksChanged = true;
 		UTrackEntry *uEntry = NewObject<UTrackEntry>();
 		uEntry->SetTrackEntry(entry);
 		trackEntries.Add(uEntry);
@@ -489,6 +580,7 @@ UTrackEntry *USpineWidget::AddEmptyAnimation(int trackIndex, float mixDuration,
 	CheckState();
 	if (state) {
 		TrackEntry *entry = state->addEmptyAnimation(trackIndex, mixDuration, delay);
+		bTracksChanged = true;
 		UTrackEntry *uEntry = NewObject<UTrackEntry>();
 		uEntry->SetTrackEntry(entry);
 		trackEntries.Add(uEntry);
@@ -517,6 +609,7 @@ void USpineWidget::ClearTracks() {
 	CheckState();
 	if (state) {
 		state->clearTracks();
+		bTracksChanged = true;
 	}
 }
 
@@ -524,6 +617,31 @@ void USpineWidget::ClearTrack(int trackIndex) {
 	CheckState();
 	if (state) {
 		state->clearTrack(trackIndex);
+		bTracksChanged = true;
+	}
+}
+
+bool USpineWidget::PlayBakedAnimation(FString animationName, float frameRate) {
+	CheckState();
+	if (!skeleton) return false;
+
+	spine::Animation *animation = skeleton->getData()->findAnimation(TCHAR_TO_UTF8(*animationName));
+	if (!animation) return false;
+
+	bakedAnimation = FSpineBakedAnimationCache::Get().FindOrBake(skeleton->getData(), skeleton->getSkin(), animation, FMath::Clamp(frameRate, 1.0f, 120.0f));
+	if (!bakedAnimation) return false;
+	bakedAnimationName = animationName;
+	bakedTime = 0;
+	bakedFrame = INDEX_NONE;
+	poseVersion++;
+	return true;
+}
+
+void USpineWidget::StopBakedAnimation() {
+	if (bakedAnimation) {
+		bakedAnimation.Reset();
+		bakedFrame = INDEX_NONE;
+		poseVersion++;
 	}
 }
 
@@ -531,6 +649,7 @@ void USpineWidget::PhysicsTranslate(float x, float y) {
 	CheckState();
 	if (skeleton) {
 		skeleton->physicsTranslate(x, y);
+		poseVersion++;
 	}
 }
 
@@ -538,6 +657,7 @@ void USpineWidget::PhysicsRotate(float x, float y, float degrees) {
 	CheckState();
 	if (skeleton) {
 		skeleton->physicsRotate(x, y, degrees);
+		poseVersion++;
 	}
 }
 
@@ -548,6 +668,7 @@ void USpineWidget::ResetPhysicsConstraints() {
 		for (int i = 0, n = (int) constraints.size(); i < n; i++) {
 			constraints[i]->reset();
 		}
+		poseVersion++;
 	}
 }
 
@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "SpineWidgetUpdater.h"
+#include "Async/ParallelFor.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/IConsoleManager.h"
+#include "SpineWidget.h"
+
+static TAutoConsoleVariable<bool> CVarSpineParallelWidgetUpdate(
+		TEXT("Spine.ParallelWidgetUpdate"),
+		false,
+		TEXT("Update the animation of all spine widgets as a parallel batch on worker threads."));
+
+FSpineWidgetUpdater &FSpineWidgetUpdater::Get() {
+	static FSpineWidgetUpdater Instance;
+	return Instance;
+}
+
+FSpineWidgetUpdater::~FSpineWidgetUpdater() {
+	if (preTickHandle.IsValid() && FSlateApplication::IsInitialized()) {
+		FSlateApplication::Get().OnPreTick().Remove(preTickHandle);
+	}
+}
+
+bool FSpineWidgetUpdater::Add(USpineWidget *Widget, float DeltaTime) {
+	if (!CVarSpineParallelWidgetUpdate.GetValueOnGameThread() || !FSlateApplication::IsInitialized() || Widget->IsDesignTime()) {
+		return false;
+	}
+
+	// the delegates may move bones between applying the animation and updating the world transform
+	if (Widget->BeforeUpdateWorldTransform.IsBound() || Widget->AfterUpdateWorldTransform.IsBound()) {
+		return false;
+	}
+
+	if (!preTickHandle.IsValid()) {
+		preTickHandle = FSlateApplication::Get().OnPreTick().AddRaw(this, &FSpineWidgetUpdater::OnPreTick);
+	}
+	// a widget painted in several places is still updated once
+	if (!queuedWidgets.ContainsByPredicate([Widget](const FQueuedWidget &queued) { return queued.widget == Widget; })) {
+		queuedWidgets.Add({Widget, DeltaTime});
+	}
+	return true;
+}
+
+void FSpineWidgetUpdater::OnPreTick(float DeltaTime) {
+	if (queuedWidgets.Num() == 0) return;
+
+	TArray<TPair<USpineWidget *, float>> widgets;
+	widgets.Reserve(queuedWidgets.Num());
+	for (const FQueuedWidget &queued : queuedWidgets) {
+		USpineWidget *widget = queued.widget.Get();
+		if (!widget) continue;
+
+		// creating the skeleton touches uobjects, only the pure skeleton update runs on the workers
+		widget->CheckState();
+		if (widget->state && widget->bAutoPlaying && !widget->bakedAnimation) widgets.Emplace(widget, queued.deltaTime);
+	}
+	queuedWidgets.Reset();
+
+	// each widget advances by the time its own update policy measured when it was painted
+	ParallelFor(widgets.Num(), [&widgets](int32 Index) {
+		widgets[Index].Key->UpdateAnimation(widgets[Index].Value);
+	});
+
+	for (const TPair<USpineWidget *, float> &widget : widgets) {
+		widget.Key->BroadcastDeferredAnimationEvents();
+	}
+}
@@ -0,0 +1,59 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USpineWidget;
+
+// Updates the animation of every painted spine widget as one parallel batch on the task graph before slate
+// ticks, instead of one widget after the other on the game thread. Skeletons are independent, animation
+// events raised on the workers are queued and broadcast on the game thread afterwards.
+// Widgets with world transform delegates bound keep updating serially. Opt in with Spine.ParallelWidgetUpdate.
+class FSpineWidgetUpdater {
+public:
+	static FSpineWidgetUpdater &Get();
+
+	~FSpineWidgetUpdater();
+
+	// queues the widget for the next batch, returns false if the widget has to be ticked directly
+	bool Add(USpineWidget *Widget, float DeltaTime);
+
+private:
+	void OnPreTick(float DeltaTime);
+
+	struct FQueuedWidget {
+		TWeakObjectPtr<USpineWidget> widget;
+		float deltaTime;
+	};
+
+	TArray<FQueuedWidget> queuedWidgets;
+	FDelegateHandle preTickHandle;
+};
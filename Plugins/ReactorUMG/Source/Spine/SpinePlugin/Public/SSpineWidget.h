@@ -35,6 +35,7 @@
 #include <spine/spine.h>
 
 class USpineWidget;
+struct FSpineBakedAnimation;
 
 class SSpineWidget : public SMeshWidget {
 
@@ -46,21 +47,69 @@ public:
 	void Construct(const FArguments &Args);
 
 	void SetData(USpineWidget *Widget);
-	FSlateBrush *brush;
 
 protected:
 	virtual int32 OnPaint(const FPaintArgs &Args, const FGeometry &AllottedGeometry, const FSlateRect &MyCullingRect, FSlateWindowElementList &OutDrawElements, int32 LayerId, const FWidgetStyle &InWidgetStyle, bool bParentEnabled) const override;
 
 	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
-	
-	void UpdateMesh(int32 LayerId, FSlateWindowElementList &OutDrawElements, const FGeometry &AllottedGeometry, spine::Skeleton *Skeleton);
 
-	void Flush(int32 LayerId, FSlateWindowElementList &OutDrawElements, const FGeometry &AllottedGeometry, int &Idx, TArray<FVector> &Vertices, TArray<int32> &Indices, TArray<FVector2D> &Uvs, TArray<FColor> &Colors, TArray<FVector> &Colors2, UMaterialInstanceDynamic *Material);
+	// applies the widget's update policy, OutDeltaTime is the time to advance the animation by
+	bool ShouldUpdate(const FGeometry &AllottedGeometry, double CurrentTime, float DeltaTime, float &OutDeltaTime);
+
+	// consecutive slots sharing a material, kept across paints and only rebuilt when the pose changes
+	struct FMeshBatch {
+		UMaterialInstanceDynamic *material = nullptr;
+		FSlateResourceHandle handle;
+		// skeleton space positions, transformed again when only the geometry changes
+		TArray<FVector2f> positions;
+		TArray<FSlateVertex> vertices;
+		TArray<SlateIndex> indices;
+	};
+
+	struct FMaterialBrush {
+		TSharedPtr<FSlateBrush> brush;
+		FSlateResourceHandle handle;
+	};
+
+	bool HaveAtlasPagesChanged() const;
+	void UpdateMaterials();
+
+	const FSlateResourceHandle &GetMaterialHandle(UMaterialInstanceDynamic *Material);
+
+	UMaterialInstanceDynamic *FindMaterial(spine::AtlasPage *Page, spine::BlendMode BlendMode) const;
+
+	FSlateRenderTransform GetMeshTransform(const FGeometry &AllottedGeometry) const;
+
+	void UpdateMesh(const FSlateRenderTransform &Transform, spine::Skeleton *Skeleton);
+
+	// copies a frame of a baked animation into the batches instead of walking the skeleton
+	void UpdateBakedMesh(const FSlateRenderTransform &Transform, const FSpineBakedAnimation &Animation, int32 FrameIndex);
+
+	void UpdateVertices(const FSlateRenderTransform &Transform);
+
+	void Flush(int32 LayerId, FSlateWindowElementList &OutDrawElements, const FMeshBatch &Batch);
 
 	virtual FVector2D ComputeDesiredSize(float) const override;
 
 	USpineWidget *widget;
-	FRenderData renderData;
+	double lastUpdateTime = -1;
+	int32 skippedUpdates = 0;
+	float skippedDeltaTime = 0;
 	FVector boundsMin;
 	FVector boundsSize;
+
+	// grown to the high water mark, batches past numMeshBatches are unused
+	TArray<FMeshBatch> meshBatches;
+	int32 numMeshBatches = 0;
+	bool bMeshValid = false;
+	uint32 meshPoseVersion = 0;
+	FLinearColor meshColor;
+	FSlateRenderTransform meshTransform;
+
+	// the page materials are only looked at again when the atlas or its page textures change
+	spine::Atlas *materialsAtlas = nullptr;
+	TArray<TWeakObjectPtr<UTexture2D>> materialPages;
+
+	// one brush per material for the widget's lifetime, every new brush name registers another slate resource
+	TMap<UMaterialInstanceDynamic *, FMaterialBrush> materialBrushes;
 };
@@ -47,6 +47,12 @@ public:
 
 	void SetRawData(const FString &RawData);
 
+	// Parses atlas text without touching UObjects, safe to call from any thread.
+	static spine::Atlas *ParseAtlas(const FString &RawData);
+
+	// Takes ownership of an atlas returned by ParseAtlas for RawData, so GetAtlas does not parse it again.
+	void SetParsedAtlas(const FString &RawData, spine::Atlas *ParsedAtlas);
+
 	FName GetAtlasFileName() const;
 
 	virtual void BeginDestroy() override;
@@ -54,6 +60,8 @@ public:
 protected:
 	spine::Atlas *atlas = nullptr;
 
+	void ClearAtlas();
+
 	UPROPERTY()
 	FString rawData;
 
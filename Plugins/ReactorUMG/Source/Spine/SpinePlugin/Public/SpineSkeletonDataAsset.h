@@ -63,8 +63,22 @@ public:
 	FName GetSkeletonDataFileName() const;
 	void SetRawData(TArray<uint8> &Data);
 
+	// Parses skeleton data against Atlas without touching UObjects, safe to call from any thread.
+	// Json data has to be null terminated.
+	static spine::SkeletonData *ParseSkeletonData(const TArray<uint8> &Data, bool bIsJson,
+												  spine::Atlas *Atlas, FString &OutError);
+
+	// Takes ownership of skeleton data returned by ParseSkeletonData for Data and Atlas, so neither
+	// LoadInfo nor GetSkeletonData parse it again.
+	void SetParsedSkeletonData(TArray<uint8> &Data, const FName &FileName, spine::Atlas *Atlas,
+							   spine::SkeletonData *ParsedSkeletonData);
+
 	virtual void BeginDestroy() override;
 
+	// Frees the skeleton data every skeleton data asset parsed against Atlas, called by the atlas asset before it
+	// frees Atlas, so an atlas allocated at the same address later never gets it back.
+	static void ReleaseNativeData(spine::Atlas *Atlas);
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	float DefaultMix = 0;
 
@@ -101,8 +115,12 @@ protected:
 
 	TMap<spine::Atlas *, NativeSkeletonData> atlasToNativeData;
 
+	void AddNativeData(spine::Atlas *Atlas, spine::SkeletonData *SkeletonData);
+
 	void ClearNativeData();
 
+	void ClearNativeData(spine::Atlas *Atlas);
+
 	void SetMixes(spine::AnimationStateData *animationStateData);
 
 #if WITH_EDITORONLY_DATA
@@ -120,4 +138,6 @@ protected:
 #endif
 
 	void LoadInfo();
+
+	void SetInfo(spine::SkeletonData *skeletonData);
 };
@@ -39,6 +39,18 @@
 
 class SSpineWidget;
 class USpineWidget;
+struct FSpineBakedAnimation;
+
+// Slate only ticks widgets it paints, so collapsed and clipped widgets are never updated except with Always
+UENUM(BlueprintType)
+enum class ESpineWidgetUpdatePolicy : uint8 {
+	// the time spent hidden is caught up on the next paint
+	Always,
+	WhenVisible,
+	// while visible, less often the further the on-screen size is below FullRateSize
+	ScaledBySize,
+	Paused
+};
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSpineWidgetBeforeUpdateWorldTransformDelegate, USpineWidget *, skeleton);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSpineWidgetAfterUpdateWorldTransformDelegate, USpineWidget *, skeleton);
@@ -87,6 +99,13 @@ public:
 	UPROPERTY(Category = Spine, EditAnywhere, BlueprintReadOnly)
 	FSlateBrush Brush;
 
+	UPROPERTY(Category = Spine, EditAnywhere, BlueprintReadWrite)
+	ESpineWidgetUpdatePolicy UpdatePolicy = ESpineWidgetUpdatePolicy::WhenVisible;
+
+	// on-screen size in pixels from which ScaledBySize updates every frame
+	UPROPERTY(Category = Spine, EditAnywhere, BlueprintReadWrite, meta = (ClampMin = 1))
+	float FullRateSize = 128;
+
 	UFUNCTION(BlueprintPure, Category = "Components|Spine|Skeleton")
 	void GetSkins(TArray<FString> &Skins);
 
@@ -210,6 +229,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Components|Spine|Animation")
 	void ClearTrack(int trackIndex);
 
+	/* Plays a looping animation from meshes sampled once at FrameRate and shared by every widget playing it,
+	 * instead of evaluating the skeleton each frame. Meant for idle loops without mixing, physics or events.
+	 * SetAnimation and SetEmptyAnimation return to the regular playback. */
+	UFUNCTION(BlueprintCallable, Category = "Components|Spine|Animation")
+	bool PlayBakedAnimation(FString animationName, float frameRate = 30);
+
+	UFUNCTION(BlueprintCallable, Category = "Components|Spine|Animation")
+	void StopBakedAnimation();
+
+	UFUNCTION(BlueprintPure, Category = "Components|Spine|Animation")
+	bool IsPlayingBakedAnimation() const { return bakedAnimation.IsValid(); }
+
 	UPROPERTY(BlueprintAssignable, Category = "Components|Spine|Animation")
 	FSpineAnimationStartDelegate AnimationStart;
 
@@ -237,13 +268,31 @@ public:
 	// protected methods from plain old C function.
 	void GCTrackEntry(UTrackEntry *entry) { trackEntries.Remove(entry); }
 
+	struct FDeferredAnimationEvent {
+		spine::EventType type;
+		UTrackEntry *entry;
+		FSpineEvent event;
+	};
+
+	void BroadcastAnimationEvent(spine::EventType type, UTrackEntry *entry, const FSpineEvent &event);
+
+	// set while the animation is updated on a worker thread, events are queued instead of broadcast
+	bool bDeferAnimationEvents = false;
+	TArray<FDeferredAnimationEvent> deferredAnimationEvents;
+
 protected:
 	friend class SSpineWidget;
+	friend class FSpineWidgetUpdater;
 
 	virtual TSharedRef<SWidget> RebuildWidget() override;
 	virtual void CheckState();
 	virtual void DisposeState();
 
+	// the animation part of Tick without delegates, safe to run on a worker thread
+	void UpdateAnimation(float DeltaTime);
+	void BroadcastDeferredAnimationEvents();
+	void UpdateBakedAnimation(float DeltaTime);
+
 	TSharedPtr<SSpineWidget> slateWidget;
 
 	spine::Skeleton *skeleton;
@@ -253,6 +302,17 @@ protected:
 	USpineSkeletonDataAsset *lastData = nullptr;
 	spine::Skin *customSkin = nullptr;
 	float physicsTimeScale;
+	// bumped whenever the pose may have changed, SSpineWidget only rebuilds its mesh when it differs
+	uint32 poseVersion = 0;
+	// set when tracks change, poseVersion is bumped once the next update has applied them
+	bool bTracksChanged = false;
+
+	// set while a baked animation plays, SSpineWidget then draws bakedFrame instead of the skeleton.
+	// bakedFrame stays INDEX_NONE until the first tick after the bake is ready
+	TSharedPtr<const FSpineBakedAnimation> bakedAnimation;
+	FString bakedAnimationName;
+	float bakedTime = 0;
+	int32 bakedFrame = INDEX_NONE;
 
 	// Need to hold on to the dynamic instances, or the GC will kill us while updating them
 	UPROPERTY()
@@ -0,0 +1,199 @@
+import * as UE from 'ue';
+
+/**
+ * Opcodes of the command buffer, keep in sync with EUMGCommitOp in UMGCommitBatch.h
+ */
+const enum CommitOp {
+    SetBool = 1,
+    SetNumber = 2,
+    SetString = 3,
+    SetObject = 4,
+    AppendChild = 5,
+    RemoveChild = 6,
+    Sync = 7,
+    Release = 8,
+}
+
+const INITIAL_CAPACITY = 4096;
+
+/**
+ * Records widget mutations made during a React commit into a packed ArrayBuffer
+ * and applies them with a single UMGCommitBatch.ApplyCommands call in resetAfterCommit.
+ * Widgets touched by the batch are synchronized once per commit on the native side.
+ * The native batch holds the handle tables of this env and is collected with it.
+ */
+export class CommitBatch {
+    private buffer: ArrayBuffer;
+    private view: DataView;
+    private length: number;
+    private handles: WeakMap<object, number>;
+    private nameIds: Map<string, number>;
+    private native: UE.UMGCommitBatch;
+
+    constructor() {
+        this.buffer = new ArrayBuffer(INITIAL_CAPACITY);
+        this.view = new DataView(this.buffer);
+        this.length = 0;
+        this.handles = new WeakMap();
+        this.nameIds = new Map();
+        this.native = new UE.UMGCommitBatch();
+    }
+
+    /**
+     * Whether a value can be written into the command buffer, other values must go through puerts.merge
+     */
+    static isBatchable(value: any): boolean {
+        const type = typeof value;
+        return type === 'boolean' || type === 'number' || type === 'string'
+            || value === null || value instanceof UE.Object;
+    }
+
+    /**
+     * @returns false if the value is not batchable, the caller should fall back to puerts.merge
+     */
+    setProperty(target: UE.Object, name: string, value: any): boolean {
+        if (!target || !CommitBatch.isBatchable(value)) {
+            return false;
+        }
+
+        const handle = this.handleOf(target);
+        const nameId = this.nameIdOf(name);
+        switch (typeof value) {
+            case 'boolean':
+                this.writeHeader(CommitOp.SetBool, handle);
+                this.writeInt32(nameId);
+                this.writeInt32(value ? 1 : 0);
+                break;
+            case 'number':
+                this.writeHeader(CommitOp.SetNumber, handle);
+                this.writeInt32(nameId);
+                this.writeFloat64(value);
+                break;
+            case 'string':
+                this.writeHeader(CommitOp.SetString, handle);
+                this.writeInt32(nameId);
+                this.writeString(value);
+                break;
+            default:
+                this.writeHeader(CommitOp.SetObject, handle);
+                this.writeInt32(nameId);
+                this.writeInt32(value ? this.handleOf(value) : -1);
+                break;
+        }
+
+        return true;
+    }
+
+    /**
+     * Request SynchronizeProperties for a widget or panel slot at the end of the commit
+     */
+    sync(target: UE.Object) {
+        if (target) {
+            this.writeHeader(CommitOp.Sync, this.handleOf(target));
+        }
+    }
+
+    appendChild(parent: UE.PanelWidget, child: UE.Widget) {
+        if (parent && child) {
+            this.writeHeader(CommitOp.AppendChild, this.handleOf(parent));
+            this.writeInt32(this.handleOf(child));
+        }
+    }
+
+    removeChild(parent: UE.PanelWidget, child: UE.Widget) {
+        if (parent && child) {
+            this.writeHeader(CommitOp.RemoveChild, this.handleOf(parent));
+            this.writeInt32(this.handleOf(child));
+        }
+    }
+
+    /**
+     * Drop the native handle of an object that will not be referenced anymore
+     */
+    release(target: UE.Object) {
+        if (!target) {
+            return;
+        }
+
+        const handle = this.handles.get(target);
+        if (handle !== undefined) {
+            this.handles.delete(target);
+            this.writeHeader(CommitOp.Release, handle);
+        }
+    }
+
+    flush() {
+        if (this.length === 0) {
+            return;
+        }
+
+        const commands = new Uint8Array(this.buffer, 0, this.length);
+        this.length = 0;
+        this.native.ApplyCommands(commands);
+    }
+
+    private handleOf(target: UE.Object): number {
+        let handle = this.handles.get(target);
+        if (handle === undefined) {
+            handle = this.native.RegisterObject(target);
+            this.handles.set(target, handle);
+        }
+        return handle;
+    }
+
+    private nameIdOf(name: string): number {
+        let nameId = this.nameIds.get(name);
+        if (nameId === undefined) {
+            nameId = this.native.RegisterName(name);
+            this.nameIds.set(name, nameId);
+        }
+        return nameId;
+    }
+
+    private reserve(bytes: number) {
+        const required = this.length + bytes;
+        if (required <= this.buffer.byteLength) {
+            return;
+        }
+
+        let capacity = this.buffer.byteLength * 2;
+        while (capacity < required) {
+            capacity *= 2;
+        }
+
+        const grown = new ArrayBuffer(capacity);
+        new Uint8Array(grown).set(new Uint8Array(this.buffer, 0, this.length));
+        this.buffer = grown;
+        this.view = new DataView(grown);
+    }
+
+    private writeHeader(op: CommitOp, handle: number) {
+        this.writeInt32(op);
+        this.writeInt32(handle);
+    }
+
+    private writeInt32(value: number) {
+        this.reserve(4);
+        this.view.setInt32(this.length, value, true);
+        this.length += 4;
+    }
+
+    private writeFloat64(value: number) {
+        this.reserve(8);
+        this.view.setFloat64(this.length, value, true);
+        this.length += 8;
+    }
+
+    private writeString(value: string) {
+        const len = value.length;
+        const bytes = (len * 2 + 3) & ~3;
+        this.writeInt32(len);
+        this.reserve(bytes);
+        for (let i = 0; i < len; i++) {
+            this.view.setUint16(this.length + i * 2, value.charCodeAt(i), true);
+        }
+        this.length += bytes;
+    }
+}
+
+export const commitBatch = new CommitBatch();
@@ -169,6 +169,26 @@ export function findChangedProps(oldProps: any, newProps: any): any {
     return diffObjects(oldProps, newProps);
 }
 
+/**
+ * Maps the updatePolicy prop of the animated widgets (Spine, Rive) onto their native enum,
+ * an unset or unknown policy falls back to the native default of updating while visible.
+ */
+export function convertUpdatePolicy<T>(
+    updatePolicy: string | undefined,
+    policies: { Always: T, ScaledBySize: T, Paused: T, WhenVisible: T }
+): T {
+    switch (updatePolicy) {
+        case "always":
+            return policies.Always;
+        case "by-size":
+            return policies.ScaledBySize;
+        case "paused":
+            return policies.Paused;
+        default:
+            return policies.WhenVisible;
+    }
+}
+
 export function compareTwoFunctions(func1: Function, func2: Function): boolean {
     if (!func1 || !func2) return false;
     try { return func1.toString() === func2.toString(); } catch (_) { return false; }
@@ -1,8 +1,12 @@
 import * as UE from 'ue';
+import { toDelegate } from 'puerts';
 import { UMGConverter } from '../umg_converter';
+import { convertUpdatePolicy } from '../../misc/utils';
 import { Rive } from 'reactorUMG';
 
 export class RiveConverter extends UMGConverter {
+    private loadingRiveFile: string | undefined;
+
     constructor(typeName: string, props: any, outer: any) {
         super(typeName, props, outer);
     }
@@ -68,14 +72,48 @@ export class RiveConverter extends UMGConverter {
 
         const riveFile = props?.rive;
         if (riveFile) {
-            const descriptor = new UE.RiveDescriptor();
-            descriptor.RiveFile = UE.UMGManager.LoadRiveFile(rive, riveFile, __dirname);
-            descriptor.ArtboardName = artBoard;
-            descriptor.ArtboardIndex = artBoardIndex;
-            descriptor.FitType = this.convertFitType(fitType);
-            descriptor.ScaleFactor = scale;
-            descriptor.Alignment = this.convertAlignment(alignment);
-            rive.SetRiveDescriptor(descriptor);
+            this.loadingRiveFile = riveFile;
+            const onLoaded = (file: UE.Object) => {
+                if (this.loadingRiveFile !== riveFile) {
+                    return;
+                }
+                this.loadingRiveFile = undefined;
+
+                const descriptor = new UE.RiveDescriptor();
+                descriptor.RiveFile = file as UE.RiveFile;
+                descriptor.ArtboardName = artBoard;
+                descriptor.ArtboardIndex = artBoardIndex;
+                descriptor.FitType = this.convertFitType(fitType);
+                descriptor.ScaleFactor = scale;
+                descriptor.Alignment = this.convertAlignment(alignment);
+                rive.SetRiveDescriptor(descriptor);
+            };
+            const onFailed = () => {
+                console.warn(`Failed to load rive file: ${riveFile}`);
+            };
+
+            // the file is read off the game thread
+            UE.UMGManager.LoadRiveFileAsync(rive, riveFile, __dirname, toDelegate(rive, onLoaded), toDelegate(rive, onFailed));
+        }
+
+        const updatePolicy = props?.updatePolicy;
+        const fullRateSize = props?.fullRateSize;
+        if (updatePolicy || typeof fullRateSize === 'number') {
+            rive.SetUpdatePolicy(
+                updatePolicy ? convertUpdatePolicy(updatePolicy, UE.ERiveUpdatePolicy) : rive.UpdatePolicy,
+                fullRateSize ?? rive.FullRateSize
+            );
+        }
+
+        const maxUpdateRate = props?.maxUpdateRate;
+        if (typeof maxUpdateRate === 'number') {
+            rive.SetMaxUpdateRate(maxUpdateRate);
+        }
+
+        // read when the rive file is set up, so it has to come before the file finishes loading
+        const atlas = props?.atlas;
+        if (typeof atlas === 'boolean') {
+            rive.bUseTextureAtlas = atlas;
         }
 
         const RiveReady = props?.onRiveReady;
@@ -95,5 +133,8 @@ export class RiveConverter extends UMGConverter {
     update(widget: UE.Widget, oldProps: any, changedProps: any): void {
         const rive = widget as UE.RiveWidget;
         this.initRiveProps(rive, changedProps);
+        if (oldProps?.updatePolicy && !this.props?.updatePolicy) {
+            rive.SetUpdatePolicy(convertUpdatePolicy(undefined, UE.ERiveUpdatePolicy), rive.FullRateSize);
+        }
     }
 }
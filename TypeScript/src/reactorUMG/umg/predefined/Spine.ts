@@ -1,17 +1,82 @@
 import { parseToLinearColor } from '../../parsers/css_color_parser';
 import { UMGConverter } from '../umg_converter';
+import { convertUpdatePolicy } from '../../misc/utils';
 import * as UE from 'ue';
+import { toDelegate } from 'puerts';
 
 export class SpineConverter extends UMGConverter {
+    // skin and animation can only be applied once the assets being loaded have arrived
+    private loadingAssets: string | undefined;
+    private pendingSkin: string | undefined;
+    private pendingAnimation: string | undefined;
+    private bakedFrameRate: number | undefined;
+
     constructor(typeName: string, props: any, outer: any) {
         super(typeName, props, outer);
     }
 
+    private loadSpineAssets(spine: UE.SpineWidget, skel: string | undefined, atlas: string | undefined) {
+        const assets = `${skel ?? ''}|${atlas ?? ''}`;
+        this.loadingAssets = assets;
+
+        const onLoaded = (atlasAsset: UE.SpineAtlasAsset, skeletonData: UE.SpineSkeletonDataAsset) => {
+            if (this.loadingAssets !== assets) {
+                return;
+            }
+            this.loadingAssets = undefined;
+
+            spine.Atlas = atlasAsset;
+            if (skeletonData) {
+                spine.SkeletonData = skeletonData;
+            }
+            UE.UMGManager.SynchronizeWidgetProperties(spine);
+
+            if (this.pendingSkin) {
+                spine.SetSkin(this.pendingSkin);
+            }
+            if (this.pendingAnimation) {
+                this.playAnimation(spine, this.pendingAnimation);
+            }
+            this.pendingSkin = undefined;
+            this.pendingAnimation = undefined;
+        };
+
+        const onFailed = () => {
+            if (this.loadingAssets === assets) {
+                this.loadingAssets = undefined;
+            }
+            console.warn(`Failed to load spine assets: ${skel ?? atlas}`);
+        };
+
+        // files are read, parsed and decoded off the game thread
+        UE.UMGManager.LoadSpineAsync(
+            spine, skel ?? '', atlas ?? '', __dirname, toDelegate(spine, onLoaded), toDelegate(spine, onFailed)
+        );
+    }
+
+    private playAnimation(spine: UE.SpineWidget, animation: string) {
+        // baked playback samples the loop once and shares it, meant for idle loops without mixing or events
+        if (this.bakedFrameRate && this.bakedFrameRate > 0 && spine.PlayBakedAnimation(animation, this.bakedFrameRate)) {
+            return;
+        }
+        spine.SetAnimation(0, animation, true);
+    }
+
     private initSpineProps(spine: UE.SpineWidget, props: any): boolean {
         let propsInit = false;
+        const atlas = props?.atlas;
+        const skel = props?.skel;
+        if (atlas || skel) {
+            this.loadSpineAssets(spine, skel, atlas);
+        }
+
         const initSkin = props?.initSkin as string;
         if (initSkin && initSkin !== '') {
-            spine.SetSkin(initSkin);
+            if (this.loadingAssets) {
+                this.pendingSkin = initSkin;
+            } else {
+                spine.SetSkin(initSkin);
+            }
         }
 
         const color = props?.color;
@@ -24,28 +89,28 @@ export class SpineConverter extends UMGConverter {
             propsInit = true;
         }
 
-        let atlasLoaded = false;
-        const atlas = props?.atlas;
-        if (atlas) {
-            spine.Atlas = UE.UMGManager.LoadSpineAtlas(spine, atlas, __dirname);
-            atlasLoaded = true;
-            propsInit = true;
+        const updatePolicy = props?.updatePolicy;
+        if (updatePolicy) {
+            spine.UpdatePolicy = convertUpdatePolicy(updatePolicy, UE.ESpineWidgetUpdatePolicy);
         }
 
-        const skel = props?.skel;
-        if (skel) {
-            spine.SkeletonData = UE.UMGManager.LoadSpineSkeleton(spine, skel, __dirname);
-            if (!atlasLoaded) {
-                const atlasPath = skel.replace('.json', '.atlas').replace('.skel', '.atlas');
-                spine.Atlas = UE.UMGManager.LoadSpineAtlas(spine, atlasPath, __dirname);
-                atlasLoaded = true;
-                propsInit = true;
-            }
+        const fullRateSize = props?.fullRateSize;
+        if (typeof fullRateSize === 'number') {
+            spine.FullRateSize = Math.max(fullRateSize, 1);
+        }
+
+        const bakedFrameRate = props?.bakedFrameRate;
+        if (typeof bakedFrameRate === 'number') {
+            this.bakedFrameRate = bakedFrameRate;
         }
 
         const initAnimation = props?.initAnimation;
         if (initAnimation && initAnimation !== '') {
-            spine.SetAnimation(0, initAnimation, true);
+            if (this.loadingAssets) {
+                this.pendingAnimation = initAnimation;
+            } else {
+                this.playAnimation(spine, initAnimation);
+            }
         }
 
         const eventKeyMap: Record<string, string> = {
@@ -81,6 +146,9 @@ export class SpineConverter extends UMGConverter {
     update(widget: UE.Widget, oldProps: any, changedProps: any): void {
         const spine = widget as UE.SpineWidget;
         const propsInit = this.initSpineProps(spine, changedProps);
+        if (oldProps?.updatePolicy && !this.props?.updatePolicy) {
+            spine.UpdatePolicy = convertUpdatePolicy(undefined, UE.ESpineWidgetUpdatePolicy);
+        }
         if (propsInit) {
             UE.UMGManager.SynchronizeWidgetProperties(spine);
         }
@@ -103,6 +103,15 @@ export class UMGConverter extends ElementConverter {
         return null;
     }
     
+    updateWidget(widget: UE.Widget, oldProps: any, newProps: any) {
+        // removed props never show up in changedProps, predefined widgets check the current props for them
+        this.props = newProps;
+        if (this.proxy) {
+            this.proxy.props = newProps;
+        }
+        super.updateWidget(widget, oldProps, newProps);
+    }
+
     update(widget: UE.Widget, oldProps: any, changedProps: any): void {
         if (this.proxy) {
             this.proxy.update(widget, oldProps, changedProps);
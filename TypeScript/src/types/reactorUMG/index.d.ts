@@ -655,6 +655,19 @@ declare module "reactorUMG" {
         atlas?: string | undefined;
         skel?: string | undefined;
         color?: CssType.Property.Color | undefined;
+        /**
+         * when the animation advances, 'when-visible' by default; 'by-size' updates less often below fullRateSize
+         */
+        updatePolicy?: 'always' | 'when-visible' | 'by-size' | 'paused' | undefined;
+        /**
+         * on-screen size in pixels from which 'by-size' updates every frame, 128 by default
+         */
+        fullRateSize?: number | undefined;
+        /**
+         * plays initAnimation from meshes pre-sampled at this rate and shared between widgets, for looping
+         * idle animations without mixing, physics or events
+         */
+        bakedFrameRate?: number | undefined;
 
         onBeforeUpdateWorldTransform?: () => void;
         onAfterUpdateWorldTransform?: () => void;
@@ -678,6 +691,23 @@ declare module "reactorUMG" {
         fitType?: 'contain' | 'cover' | 'fill' | 'fit-width' | 'fit-height' | 'none' | 'scale-down' | 'layout' | undefined;
         scale?: number | undefined;
         alignment?: 'top-left' | 'top-center' | 'top-right' | 'center-left' | 'center' | 'center-right' | 'bottom-left' | 'bottom-center' | 'bottom-right' | undefined;
+        /**
+         * when the artboard advances and renders, 'when-visible' by default; 'by-size' updates less often below fullRateSize
+         */
+        updatePolicy?: 'always' | 'when-visible' | 'by-size' | 'paused' | undefined;
+        /**
+         * on-screen size in pixels from which 'by-size' updates every frame, 128 by default
+         */
+        fullRateSize?: number | undefined;
+        /**
+         * renders into a texture shared with other small rive widgets, only for the 'contain', 'fill', 'scale-down'
+         * and 'layout' fit types; set it when the widget is created
+         */
+        atlas?: boolean | undefined;
+        /**
+         * updates per second, every frame by default; widgets with the same rate update on the same frames
+         */
+        maxUpdateRate?: number | undefined;
 
         onRiveReady?: () => void;
         onRiveNamedEvent?: (eventName: string) => void;